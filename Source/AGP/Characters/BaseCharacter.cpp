@@ -84,6 +84,11 @@ bool ABaseCharacter::HasWeapon()
 	return (WeaponComponent != nullptr);
 }
 
+float ABaseCharacter::GetAmmoPercentage() const
+{
+	return WeaponComponent ? WeaponComponent->GetAmmoPercentage() : 0.0f;
+}
+
 UHealthComponent* ABaseCharacter::GiveHealthComponent()
 {
 	return HealthComponent;
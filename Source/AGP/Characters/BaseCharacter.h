@@ -30,6 +30,11 @@ public:
 	 */
 	void Reload();
 
+	/**
+	 * @return The fraction of the weapon's magazine that is left, or 0 if the character has no weapon.
+	 */
+	float GetAmmoPercentage() const;
+
 	void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	void OnDeath();
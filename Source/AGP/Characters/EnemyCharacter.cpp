@@ -41,6 +41,16 @@ void AEnemyCharacter::BeginPlay()
 	}
 }
 
+void AEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Free up the nodes this enemy had reserved so other enemies stop routing around them.
+	if (PathfindingSubsystem)
+	{
+		PathfindingSubsystem->ReleaseReservations(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 void AEnemyCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -97,7 +107,7 @@ void AEnemyCharacter::TickEngage()
 	
 	if (CurrentPath.IsEmpty())
 	{
-		CurrentPath = PathfindingSubsystem->GetPath(GetActorLocation(), SensedCharacter->GetActorLocation());
+		CurrentPath = PathfindingSubsystem->GetCooperativePath(this, GetActorLocation(), SensedCharacter->GetActorLocation());
 	}
 	MoveAlongPath();
 	if (HasWeapon())
@@ -134,13 +144,31 @@ void AEnemyCharacter::TickEngageStationary()
 	TimeSinceLastShot += DeltaTime;
 }
 
+void AEnemyCharacter::TickSuppress(const FVector& FireAtLocation)
+{
+	float DeltaTime = GetWorld()->GetDeltaSeconds();
+	if (HasWeapon())
+	{
+		if (WeaponComponent->IsMagazineEmpty())
+		{
+			Reload();
+		}
+		if(TimeSinceLastShot >= 0.3f)
+		{
+			Fire(FireAtLocation);
+			TimeSinceLastShot = 0.0f;
+		}
+	}
+	TimeSinceLastShot += DeltaTime;
+}
+
 void AEnemyCharacter::TickAdanceToTarget()
 {
 	if (!SensedCharacter) return;
 	
 	if (CurrentPath.IsEmpty())
 	{
-		CurrentPath = PathfindingSubsystem->GetPath(GetActorLocation(), SensedCharacter->GetActorLocation());
+		CurrentPath = PathfindingSubsystem->GetCooperativePath(this, GetActorLocation(), SensedCharacter->GetActorLocation());
 	}
 	MoveAlongPath();
 }
@@ -151,7 +179,7 @@ void AEnemyCharacter::TickGoToLocation( FVector& location)
 	{
 		if (CurrentPath.IsEmpty())
 		{
-			CurrentPath = PathfindingSubsystem->GetPath(GetActorLocation(), location);
+			CurrentPath = PathfindingSubsystem->GetCooperativePath(this, GetActorLocation(), location);
 		}
 	}
 	MoveAlongPath();
@@ -182,7 +210,7 @@ void AEnemyCharacter::TickEvade()
 
 	if (CurrentPath.IsEmpty())
 	{
-		CurrentPath = PathfindingSubsystem->GetPathAway(GetActorLocation(), SensedCharacter->GetActorLocation());
+		CurrentPath = PathfindingSubsystem->GetCooperativePathAway(this, GetActorLocation(), SensedCharacter->GetActorLocation());
 	}
 	MoveAlongPath();
 }
@@ -75,6 +75,7 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY()
 	UEnemyAgent* EnemyAgentComponent;
@@ -154,6 +155,11 @@ public:
 	void TickEngageStationary();
 	void TickAdanceToTarget();
 	void TickGoToLocation( FVector& location);
+	/**
+	 * Will stand still and fire at the location, more slowly than when engaging, whether the target can be seen or not.
+	 * @param FireAtLocation Where the target was last seen.
+	 */
+	void TickSuppress(const FVector& FireAtLocation);
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	APlayerCharacter* GetSensedCharacter();
@@ -177,6 +177,12 @@ bool UWeaponComponent::IsMagazineEmpty()
 	return RoundsRemainingInMagazine <= 0;
 }
 
+float UWeaponComponent::GetAmmoPercentage() const
+{
+	if (WeaponStats.MagazineSize <= 0) return 0.0f;
+	return FMath::Clamp(static_cast<float>(RoundsRemainingInMagazine) / WeaponStats.MagazineSize, 0.0f, 1.0f);
+}
+
 void UWeaponComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -60,6 +60,11 @@ public:
 
 	bool IsMagazineEmpty();
 
+	/**
+	 * @return The fraction of the magazine that is left, from 0 to 1.
+	 */
+	float GetAmmoPercentage() const;
+
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 protected:
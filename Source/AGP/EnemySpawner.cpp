@@ -3,12 +3,15 @@
 
 #include "EnemySpawner.h"
 
+#include "EngineUtils.h"
 #include "MultiplayerGameMode.h"
+#include "AGP/GoalActionOrientatedPlanning/EnemySquadSubsystem.h"
 #include "Characters/EnemyCharacter.h"
 #include "Characters/BaseCharacter.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Landscape/ProceduralLandscape.h"
 #include "Pathfinding/PathfindingSubsystem.h"
 
 // Sets default values
@@ -31,6 +34,14 @@ void AEnemySpawner::BeginPlay()
 	//Set the spawn parameters to ignore collision; this is so that spawns always happen. Also Get a reference to the player. 
 	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 	PlayerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(),0));
+	for (TActorIterator<AProceduralLandscape> It(GetWorld()); It; ++It)
+	{
+		if (!Landscape)
+		{
+			Landscape = *It;
+		}
+		It->OnLandscapeGenerated.AddUObject(this, &AEnemySpawner::OnLandscapeGenerated);
+	}
 	PopulateSpawnLocations();
 	UE_LOG(LogTemp, Log, TEXT("Started"));
 }
@@ -43,13 +54,22 @@ void AEnemySpawner::Tick(float DeltaTime)
 	//Using Player kill count, determine how many times to spawn an enemy. Use a timer to determine when spawns will happen. 
 	if (SpawnTimer <= 0.0f)
 	{
+		TArray<AEnemyCharacter*, TInlineAllocator<8>> SpawnedEnemies;
 		for (int8 i = 0; i < GetEnemySpawnAmount(PlayerCharacter->GetEnemiesKilledInLastMinute()); i++)
 		{
 			if (HasAuthority())
 			{
-				SpawnEnemy();
+				if (AEnemyCharacter* Enemy = SpawnEnemy())
+				{
+					SpawnedEnemies.Add(Enemy);
+				}
 			}	
 		}
+		//Enemies spawned together go after the player as a squad, which plans who suppresses, flanks and advances.
+		if (SpawnedEnemies.Num() > 1)
+		{
+			GetWorld()->GetSubsystem<UEnemySquadSubsystem>()->CreateSquad(SpawnedEnemies);
+		}
 		SpawnTimer += 5.0f;
 	}
 
@@ -61,7 +81,7 @@ void AEnemySpawner::Tick(float DeltaTime)
 	SpawnTimer -= DeltaTime;
 }
 
-void AEnemySpawner::SpawnEnemy()
+AEnemyCharacter* AEnemySpawner::SpawnEnemy()
 {
 
 	
@@ -69,10 +89,14 @@ void AEnemySpawner::SpawnEnemy()
 	if (const AMultiplayerGameMode* GameInstance = Cast<AMultiplayerGameMode>(GetWorld()->GetAuthGameMode()))
 	{
 		UE_LOG(LogTemp, Log, TEXT("Found GameInstance"));
-		//Find a spawn location around the player. Then Make sure it is above ground.
+		//Find a spawn location around the player. The locations are on the ground, so lift the enemy by half its
+		//capsule for it to stand on it.
 		FVector SpawnPosition =
 			PossibleSpawnLocations[FMath::RandRange(0, PossibleSpawnLocations.Num()-1)];
-		SpawnPosition.Z += 50.0f;
+		if (const ACharacter* DefaultEnemy = Cast<ACharacter>(GameInstance->GetEnemyClass()->GetDefaultObject()))
+		{
+			SpawnPosition.Z += DefaultEnemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		}
 
 		//Spawn Enemy and generate a stats struct for it using helper methods.
 		AEnemyCharacter* Enemy = GetWorld()->SpawnActor<AEnemyCharacter>(GameInstance->GetEnemyClass(), SpawnPosition, FRotator::ZeroRotator, SpawnParameters);
@@ -93,13 +117,13 @@ void AEnemySpawner::SpawnEnemy()
 			Enemy->Multicast_SetMeshSize(ScaleFactor);
 			UE_LOG(LogTemp, Log, TEXT("Spawned"));
 		}
-		
+		return Enemy;
 	}
 	else
 	{
 		UE_LOG(LogTemp, Log, TEXT("Could not find Game Intstance"));
 	}
-	
+	return nullptr;
 }
 
 void AEnemySpawner::IncreaseKill(bool bIsSpecialKill)
@@ -295,12 +319,14 @@ void AEnemySpawner::PopulateSpawnLocations()
 	{
 		PossibleSpawnLocations = PathfindingSubsystem->GetWaypointPositions();
 	}
+	// Put the locations on the actual ground rather than trusting where the nodes were placed.
+	if (Landscape)
+	{
+		Landscape->SnapLocationsToGround(PossibleSpawnLocations);
+	}
 }
 
-
-
-
-
-
-
-
+void AEnemySpawner::OnLandscapeGenerated(AProceduralLandscape* GeneratedLandscape)
+{
+	PopulateSpawnLocations();
+}
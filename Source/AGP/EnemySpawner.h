@@ -6,8 +6,10 @@
 #include "GameFramework/Actor.h"
 #include "EnemySpawner.generated.h"
 
+class AEnemyCharacter;
 class APlayerCharacter;
 class ABaseCharacter;
+class AProceduralLandscape;
 
 UCLASS()
 class AGP_API AEnemySpawner : public AActor
@@ -28,6 +30,11 @@ protected:
 	float SpawnTimer = 5.0f;
 
 	APlayerCharacter* PlayerCharacter;
+	/**
+	 * The landscape that spawn locations are snapped to. Null if the level doesn't have a procedural landscape.
+	 */
+	UPROPERTY()
+	AProceduralLandscape* Landscape;
 
 	FActorSpawnParameters SpawnParameters;
 
@@ -41,6 +48,10 @@ protected:
 
 	TArray<FVector> PossibleSpawnLocations;
 	void PopulateSpawnLocations();
+	/**
+	 * Refreshes the spawn locations once a landscape has finished generating and placed its new navigation nodes.
+	 */
+	void OnLandscapeGenerated(AProceduralLandscape* GeneratedLandscape);
 
 
 	UPROPERTY()
@@ -55,7 +66,10 @@ protected:
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
-	void SpawnEnemy();
+	/**
+	 * @return The enemy that was spawned, or null if it couldn't be.
+	 */
+	AEnemyCharacter* SpawnEnemy();
 
 	void IncreaseKill(bool bIsSpecialKill);
 
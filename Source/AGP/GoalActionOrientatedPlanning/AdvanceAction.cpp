@@ -5,49 +5,64 @@
 #include "EnemyAgentBeliefs.h"
 #include "AGP/Characters/EnemyCharacter.h"
 
+namespace
+{
+	constexpr FGOAPActionDescriptor AdvanceActionDescriptor = FGOAPActionDescriptor(1.0f)
+		.Requires(GOAPFacts::TargetSpotted, false)
+		.Causes(GOAPFacts::WithinRange, true)
+		.Causes(GOAPFacts::AttackingTarget, true);
+}
+
 UAdvanceAction::UAdvanceAction()
 {
-	cost = 1.0f;
-	Effects.Add("WithinRange", true);
-	Effects.Add("AttackingTarget", true); 
+	SetDescriptor(AdvanceActionDescriptor);
 }
 
-bool UAdvanceAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UAdvanceAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
 	//check if a target is directly spotted
-	const bool bNoTargetSpotted = !EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"];
+	const bool bNoTargetSpotted = !Beliefs.GetBelief(GOAPFacts::TargetSpotted);
 	const bool bLastKnownPosition =
-		EnemyAgent->GetBeliefs()->GetBeliefsStateVectors()["LastKnownTargetPosition"] != FVector::ZeroVector;
+		Beliefs.GetBeliefsStateVectorsConst().FindRef("LastKnownTargetPosition") != FVector::ZeroVector;
+
+	return bNoTargetSpotted && bLastKnownPosition;
+}
+
+float UAdvanceAction::GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const float Cost = Super::GetCost(WorldState, Beliefs);
+	const UEnemyAgentBeliefs* EnemyBeliefs = Cast<UEnemyAgentBeliefs>(&Beliefs);
+	if (!EnemyBeliefs) return Cost;
 
-	return bNoTargetSpotted && !bLastKnownPosition;
+	// Walking further to where the target was last seen takes longer
+	return Cost + EnemyBeliefs->GetDistanceToTarget() / 2000.0f;
 }
 
-void UAdvanceAction::PerformAction()
+void UAdvanceAction::PerformAction(FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter());
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent); 
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
 	EnemyCharacter->TickGoToLocation(EnemyAgent->GetBeliefs()->GetBeliefsStateVectors()["LastKnownTargetPosition"]);
 	
 }
 
-bool UAdvanceAction::IsActionComplete() const
+bool UAdvanceAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter());
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
 	const float DistanceToLastKnownPosition =
 		FVector::Dist(EnemyAgent->GetBeliefs()->GetBeliefsStateVectors()["LastKnownTargetPosition"],
 		EnemyCharacter->GetActorLocation());
 	
 	//check if a target is directly spotted
-	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"];\
+	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::TargetSpotted);
 
 	return bTargetSpotted || DistanceToLastKnownPosition <= 25.0f;
 }
 
-void UAdvanceAction::ApplyEffects(UWorldState& WorldState)
+void UAdvanceAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
+	Super::ApplyEffects(Context, WorldState);
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent); 
 	EnemyAgent->GetBeliefs()->GetBeliefsStateVectors()["LastKnownTargetPosition"] = FVector::ZeroVector;
 }
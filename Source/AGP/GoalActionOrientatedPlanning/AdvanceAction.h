@@ -14,9 +14,10 @@ class AGP_API UAdvanceAction : public UAction
 {
 	GENERATED_BODY()
 	UAdvanceAction();
-	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)override;
-	virtual void PerformAction() override;
-	virtual bool IsActionComplete() const override;
-	virtual void ApplyEffects(UWorldState& WorldState) override;
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual float GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 	
 };
@@ -8,14 +8,15 @@
 UChaseThief::UChaseThief()
 {
 	Priority = 2;
-	GoalState.Add("ThiefVisible", true); 
+	RelevanceFacts.Set(GOAPFacts::ThiefVisible, true);
+	GoalState.Set(GOAPFacts::ThiefVisible, false);
 }
 
 bool UChaseThief::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
 	if (const UPatrolAgentBeliefs* PatrolBeliefs = Cast<const UPatrolAgentBeliefs>(&Beliefs))
 	{
-		const FVector PatrolAgentPosition = WorldState.VectorStates["ThiefAgentLocation"];
+		const FVector PatrolAgentPosition = WorldState.VectorStates.FindRef(TEXT("ThiefAgentLocation"));
 		const FVector SightingOfThief = PatrolBeliefs->GetThiefCurrentLocation();
 		return PatrolBeliefs->IsThiefVisible() == false|| FVector::Dist(PatrolAgentPosition, SightingOfThief) <= 100.0f ;
 	}
@@ -24,8 +25,8 @@ bool UChaseThief::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs&
 
 bool UChaseThief::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-	return Beliefs.GetBeliefsState().Contains("ThiefVisible")
-	&& Beliefs.GetBeliefsState()["ThiefVisible"]
+	return Beliefs.HasBelief(GOAPFacts::ThiefVisible)
+	&& Beliefs.GetBelief(GOAPFacts::ThiefVisible)
 	&& Beliefs.GetBeliefsStateVectors().Contains("ThiefVisible")
 	&& Beliefs.GetBeliefsStateVectors()["ThiefVisible"] != FVector::Zero();
 }
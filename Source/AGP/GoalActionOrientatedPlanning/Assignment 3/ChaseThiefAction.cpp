@@ -10,27 +10,35 @@
 #include "PatrolAgentBeliefs.h"
 #include "PatrolGoal.h"
 
+namespace
+{
+	// Set a higher cost for chasing
+	constexpr FGOAPActionDescriptor ChaseThiefActionDescriptor = FGOAPActionDescriptor(2.0f)
+		// The thief must be visible to chase
+		.Requires(GOAPFacts::ThiefVisible, true)
+		// After the action, the thief should no longer be visible
+		//.Causes(GOAPFacts::ThiefLastKnownLocation, true)
+		.Causes(GOAPFacts::ThiefVisible, false);
+}
+
 UChaseThiefAction::UChaseThiefAction()
 {
-	cost = 2.0f;  // Set a higher cost for chasing
-	Preconditions.Add("ThiefVisible", true);  // The thief must be visible to chase 
-	//Effects.Add("ThiefVisible", false);  // After the action, the thief should no longer be visible 
-	//Effects.Add("ThiefLastKnownLocation", true);  // After the action, the thief should no longer be visible
+	SetDescriptor(ChaseThiefActionDescriptor);
 	//EffectVectors.Add("ThiefVisible", FVector::Zero());  // After the action, the thief should no longer be visible
-	//EffectVectors.Add("ThiefLastKnownLocation", FVector::Zero());  
+	//EffectVectors.Add("ThiefLastKnownLocation", FVector::Zero());
 }
 
-bool UChaseThiefAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UChaseThiefAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 { 
-	return false;
+	const UPatrolAgentBeliefs* DerivedBeliefs = Cast<const UPatrolAgentBeliefs>(&Beliefs);
+	return DerivedBeliefs && DerivedBeliefs->IsThiefVisible();
 }
 
-void UChaseThiefAction::PerformAction()
+void UChaseThiefAction::PerformAction(FGOAPActionContext& Context) const
 {
-	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(GetOuter()))
+	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(Context.Agent))
 	{
-		Character = Cast<ACharacter>(Agent->GetOwner());
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+		UCharacterMovementComponent* MovementComp = Context.Character->GetCharacterMovement();
 		//Dosen't work for some reason...
 		//MovementComp->MaxWalkSpeed =  Agent->GetRunSpeed();
 		MovementComp->MaxWalkSpeed =  250.0f;
@@ -39,22 +47,22 @@ void UChaseThiefAction::PerformAction()
 	} 
 }
 
-bool UChaseThiefAction::IsActionComplete() const
+bool UChaseThiefAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(GetOuter()))
+	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(Context.Agent))
 	{
 		UWorldState* WorldState = Agent->GetWorldState();
 		FVector enemyPos = WorldState->GetWorldVectorState()["PatrolAgentPosition"];
 		FVector thiefPos = WorldState->GetWorldVectorState()["ThiefAgentLocation"];
 		if(FVector::Dist(enemyPos, thiefPos)<=50.0f){
-			WorldState->SetState("GoldTaken", false); // during the process of chasing the thief, if they get close, take the gold back lol
+			WorldState->SetState(GOAPFacts::GoldTaken, false); // during the process of chasing the thief, if they get close, take the gold back lol
 			}
 		return !Agent->GetBeliefs()->IsThiefVisible();
 	}
 	return false;
 }
 
-void UChaseThiefAction::ApplyEffects(UWorldState& WorldState)
+void UChaseThiefAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
+	Super::ApplyEffects(Context, WorldState);
 }
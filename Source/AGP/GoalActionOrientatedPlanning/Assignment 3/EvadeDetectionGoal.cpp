@@ -6,15 +6,16 @@
 UEvadeDetectionGoal::UEvadeDetectionGoal()
 {
 	Priority = 5;
-	GoalState.Add("ThiefVisible", false);
+	GoalState.Set(GOAPFacts::ThiefVisible, false);
+	RelevanceFacts.Set(GOAPFacts::ThiefVisible, true);
 }
 
 bool UEvadeDetectionGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	return WorldState.GetWorldState()["ThiefVisible"] == false;
+	return WorldState.GetState(GOAPFacts::ThiefVisible) == false;
 }
 
 bool UEvadeDetectionGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-	return WorldState.GetWorldState()["ThiefVisible"] == true;
+	return WorldState.GetState(GOAPFacts::ThiefVisible) == true;
 }
@@ -13,26 +13,30 @@
 
 class UThiefAgent;
 
+namespace
+{
+	constexpr FGOAPActionDescriptor HideActionDescriptor = FGOAPActionDescriptor(1.0f)
+		.Requires(GOAPFacts::ThiefVisible, true)
+		.Causes(GOAPFacts::ThiefVisible, false);
+}
+
 UHideAction::UHideAction()
 {
-	cost = 1.0f;  
-	Preconditions.Add("ThiefVisible", true);  
-	Effects.Add("ThiefVisible", false);  
-	//EffectVectors.Add("ThiefVisible", FVector::Zero());  
+	SetDescriptor(HideActionDescriptor);
+	//EffectVectors.Add("ThiefVisible", FVector::Zero());
 }
 
-bool UHideAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UHideAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	return WorldState.GetWorldState()["ThiefVisible"] == true;
+	return WorldState.GetState(GOAPFacts::ThiefVisible) == true;
 }
 
-void UHideAction::PerformAction()
+void UHideAction::PerformAction(FGOAPActionContext& Context) const
 {
-	if(UThiefAgent* Agent = Cast<UThiefAgent>(GetOuter()))
+	if(UThiefAgent* Agent = Cast<UThiefAgent>(Context.Agent))
 	{
 		FVector HidePoint;
-		Character = Cast<ACharacter>(Agent->GetOwner());
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+		UCharacterMovementComponent* MovementComp = Context.Character->GetCharacterMovement();
 		MovementComp->MaxWalkSpeed =  350.0f;
 		if(!Agent->WayPoint)
 			HidePoint = Agent->FurthestPoint();
@@ -43,14 +47,14 @@ void UHideAction::PerformAction()
 	
 }
 
-bool UHideAction::IsActionComplete() const
+bool UHideAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	if(UThiefAgent* Agent = Cast<UThiefAgent>(GetOuter()))
+	if(UThiefAgent* Agent = Cast<UThiefAgent>(Context.Agent))
 	{
 		/*
 		if (Agent->InLOS() == false)
 		{
-			Agent->GetWorldState()->SetState("ThiefVisible", false);
+			Agent->GetWorldState()->SetState(GOAPFacts::ThiefVisible, false);
 			return true;
 		}
 		*/
@@ -61,7 +65,7 @@ bool UHideAction::IsActionComplete() const
 
 		if ( FVector::Dist(thiefPos, enemyPos) <= 50.0f)
 		{
-			Agent->GetWorldState()->SetState("ThiefVisible", false);
+			Agent->GetWorldState()->SetState(GOAPFacts::ThiefVisible, false);
 			Agent->WayPoint = nullptr;
 			return true;
 		}
@@ -69,7 +73,7 @@ bool UHideAction::IsActionComplete() const
 	return false;
 }
 
-void UHideAction::ApplyEffects(UWorldState& WorldState)
+void UHideAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
+	Super::ApplyEffects(Context, WorldState);
 }
@@ -11,25 +11,28 @@
 
 class UCharacterMovementComponent;
 
+namespace
+{
+	constexpr FGOAPActionDescriptor InvestigateAreaActionDescriptor = FGOAPActionDescriptor(1.5f)
+		.Requires(GOAPFacts::ThiefVisible, false)
+		.Requires(GOAPFacts::ThiefLastKnownLocation, true)
+		.Causes(GOAPFacts::ThiefLastKnownLocation, false);
+}
+
 UInvestigateAreaAction::UInvestigateAreaAction()
 {
-	cost = 1.5;
-	Preconditions.Add("ThiefVisible", false);
-	Preconditions.Add("ThiefLastKnownLocation", true);
+	SetDescriptor(InvestigateAreaActionDescriptor);
 	EffectVectors.Add("ThiefVisible", FVector::Zero());
-	Effects.Add("ThiefLastKnownLocation", false);
-	RandomPosition = FVector::Zero();
 }
 
-bool UInvestigateAreaAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UInvestigateAreaAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
 	const UPatrolAgentBeliefs* DerivedBeliefs = Cast<const UPatrolAgentBeliefs>(&Beliefs);
 	return !DerivedBeliefs->GetThiefsLastKnownLocation().IsZero() && DerivedBeliefs->IsThiefVisible() == false;
 }
 
-FVector UInvestigateAreaAction::GetRandomPoint()
+FVector UInvestigateAreaAction::GetRandomPoint(const AActor* OwnerActor) const
 {
-	AActor* OwnerActor = Cast<UPatrolAgent>(GetOuter())->GetOwner();
 	UNavigationSystemV1* NavSystem = UNavigationSystemV1::GetCurrent(OwnerActor->GetWorld());
 	FVector Origin = OwnerActor->GetActorLocation();
 	FVector RandomPoint;
@@ -45,18 +48,17 @@ FVector UInvestigateAreaAction::GetRandomPoint()
 	return RandomPoint;
 }
 
-void UInvestigateAreaAction::PerformAction()
+void UInvestigateAreaAction::PerformAction(FGOAPActionContext& Context) const
 {
-	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(GetOuter()))
+	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(Context.Agent))
 	{
-		Character = Cast<ACharacter>(Agent->GetOwner());
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+		UCharacterMovementComponent* MovementComp = Context.Character->GetCharacterMovement();
 		MovementComp->MaxWalkSpeed = Agent->GetRunSpeed();
 		AActor* OwnerActor = Agent->GetOwner();
 		UPatrolAgentBeliefs* PatrolBeliefs = Cast<UPatrolAgentBeliefs>(Agent->GetBeliefs());
 		if (PatrolBeliefs)
 		{
-			if (!bInvestigateArea)
+			if (!Context.bStarted)
 			{
 				// Move to the thief's last known location
 				FVector Location = PatrolBeliefs->GetThiefsLastKnownLocation();
@@ -65,38 +67,38 @@ void UInvestigateAreaAction::PerformAction()
 				// Check if the patrol agent has arrived at the thief's last known location
 				if (FVector::Dist(OwnerActor->GetActorLocation(), Location) <= 50.0f)
 				{
-					bInvestigateArea = true;
-					RandomPosition = GetRandomPoint();  // Get a random point to investigate
+					Context.bStarted = true;
+					Context.TargetLocation = GetRandomPoint(OwnerActor);  // Get a random point to investigate
 				}
 			}
             
 			// If the agent has already investigated the last known location, move to the random point
-			if (bInvestigateArea && RandomPosition != FVector::Zero())
+			if (Context.bStarted && Context.TargetLocation != FVector::Zero())
 			{
-				Agent->MoveToLocation(RandomPosition);
+				Agent->MoveToLocation(Context.TargetLocation);
 
-				if (FVector::Dist(OwnerActor->GetActorLocation(), RandomPosition) <= 50.0f)
+				if (FVector::Dist(OwnerActor->GetActorLocation(), Context.TargetLocation) <= 50.0f)
 				{
-					bInvestigationDone = true;
+					Context.bDone = true;
 				}
 			}
 		}
 
 		if(PatrolBeliefs->IsThiefVisible())
 		{
-			Effects.Add("ThiefVisible", true);
+			Context.ExtraEffects.Set(GOAPFacts::ThiefVisible, true);
 		}
 	}
 }
 
-bool UInvestigateAreaAction::IsActionComplete() const
+bool UInvestigateAreaAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	return bInvestigationDone;
+	return Context.bDone;
 		
 }
 
-void UInvestigateAreaAction::ApplyEffects(UWorldState& WorldState)
+void UInvestigateAreaAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
+	Super::ApplyEffects(Context, WorldState);
 	WorldState.SetVectorState("ThiefLastKnownLocation", FVector::ZeroVector);
 }
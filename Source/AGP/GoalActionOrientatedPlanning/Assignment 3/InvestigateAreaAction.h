@@ -19,26 +19,15 @@ public:
 	UInvestigateAreaAction();
 	
 	// Check if the agent can investigate (is there a last known location?)
-	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) override;
-	FVector GetRandomPoint();
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	FVector GetRandomPoint(const AActor* OwnerActor) const;
 
 	// Investigate the last known location
-	virtual void PerformAction() override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
 
 	// Check if the action is complete (e.g., investigation is finished)
-	virtual bool IsActionComplete() const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
 
 	// Apply effects to the world state (e.g., after investigating)
-	virtual void ApplyEffects(UWorldState& WorldState) override;
-
-protected:
-	UPROPERTY()
-	bool bDelayActive = true;
-	UPROPERTY()
-	bool bInvestigateArea = false;
-	UPROPERTY()
-	bool bInvestigationDone = false;
-	UPROPERTY()
-	FVector RandomPosition;
-	
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 };
@@ -7,8 +7,10 @@
 
 UInvestigateGoal::UInvestigateGoal()
 {
-	GoalState.Add("ThiefVisible", true);
+	GoalState.Set(GOAPFacts::ThiefLastKnownLocation, false);
 	Priority = 3; 
+	RelevanceFacts.Set(GOAPFacts::ThiefVisible, true);
+	RelevanceFacts.Set(GOAPFacts::ThiefLastKnownLocation, true);
 }
 
 bool UInvestigateGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
@@ -24,8 +26,8 @@ bool UInvestigateGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeli
 
 bool UInvestigateGoal::IsGoalRelevant(const UWorldState& WorldState,  UBeliefs& Beliefs) const
 {
-	return Beliefs.GetBeliefsState().Contains("ThiefVisible")
-	&& !Beliefs.GetBeliefsState()["ThiefVisible"]
+	return Beliefs.HasBelief(GOAPFacts::ThiefVisible)
+	&& !Beliefs.GetBelief(GOAPFacts::ThiefVisible)
 	&& Beliefs.GetBeliefsStateVectors().Contains("ThiefLastKnownPosition")
 	&& Beliefs.GetBeliefsStateVectors()["ThiefLastKnownPosition"] != FVector::ZeroVector;
 				
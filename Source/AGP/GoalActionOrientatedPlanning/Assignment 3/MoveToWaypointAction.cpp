@@ -9,36 +9,42 @@
 
 class UCharacterMovementComponent;
 
+namespace
+{
+	constexpr FGOAPActionDescriptor MoveToWaypointActionDescriptor = FGOAPActionDescriptor(1.0f)
+		//.Requires(GOAPFacts::AtWaypoint, false)
+		.Requires(GOAPFacts::ThiefVisible, false)
+		.Causes(GOAPFacts::AtWaypoint, true);
+}
+
 UMoveToWaypointAction::UMoveToWaypointAction()
 {
-	cost = 1.0f; 
-	//Preconditions.Add("HasWaypoint", true);  
-	//Preconditions.Add("AtWaypoint", false);   
-	Preconditions.Add("ThiefVisible", false);  
-	//PreconditionsVectors.Add("ThiefVisible", FVector::Zero());  
-	//PreconditionsVectors.Add("ThiefLastKnownPosition", FVector::Zero());  
+	SetDescriptor(MoveToWaypointActionDescriptor);
+	//Preconditions.Add("HasWaypoint", true);
+	//PreconditionsVectors.Add("ThiefVisible", FVector::Zero());
+	//PreconditionsVectors.Add("ThiefLastKnownPosition", FVector::Zero());
 	//TODO: Create Patrol nodes and add them to an array from which the agent can patrol around
-	
 }
 
-bool UMoveToWaypointAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UMoveToWaypointAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
 	const UPatrolAgentBeliefs* DerivedBeliefs = Cast<const UPatrolAgentBeliefs>(&Beliefs); 
 	return DerivedBeliefs->IsThiefVisible() == false; 
 }
 
-void UMoveToWaypointAction::ApplyEffects(UWorldState& WorldState)
+void UMoveToWaypointAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
-	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(GetOuter()))
+	Super::ApplyEffects(Context, WorldState);
+	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(Context.Agent))
 	{
-		Agent->UpdateBelief("AtWaypoint", true);
+		// The next waypoint has already been picked, so the agent isn't at its waypoint any more
+		Agent->UpdateBelief(GOAPFacts::AtWaypoint, false);
 	}
 }
 
-bool UMoveToWaypointAction::IsActionComplete() const
+bool UMoveToWaypointAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	UPatrolAgent* Agent = Cast<UPatrolAgent>(GetOuter());
+	UPatrolAgent* Agent = Cast<UPatrolAgent>(Context.Agent);
 	if (Agent)
 	{
 		const FVector NextPosition = Agent->CurrentWayPoint->GetActorLocation();
@@ -55,13 +61,12 @@ bool UMoveToWaypointAction::IsActionComplete() const
 	return false;
 }
 
-void UMoveToWaypointAction::PerformAction()
+void UMoveToWaypointAction::PerformAction(FGOAPActionContext& Context) const
 {
-	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(GetOuter()))
+	if (UPatrolAgent* Agent = Cast<UPatrolAgent>(Context.Agent))
 	{
-		Agent->UpdateBelief("AtWaypoint", false);
-		Character = Cast<ACharacter>(Agent->GetOwner());
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+		Agent->UpdateBelief(GOAPFacts::AtWaypoint, false);
+		UCharacterMovementComponent* MovementComp = Context.Character->GetCharacterMovement();
 		MovementComp->MaxWalkSpeed = Agent->GetNormalSpeed();
 		Agent->GetAaiController()->MoveToActor(Agent->CurrentWayPoint , 100.0f);
 	}
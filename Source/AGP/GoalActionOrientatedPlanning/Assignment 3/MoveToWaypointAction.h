@@ -17,8 +17,8 @@ class AGP_API UMoveToWaypointAction : public UAction
 
 public:
 	UMoveToWaypointAction(); 
-	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) override;
-	virtual void ApplyEffects (UWorldState& WorldState)override;
-	virtual bool IsActionComplete() const override;
-	virtual void PerformAction()override;
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
 };
@@ -37,7 +37,7 @@ void UPatrolAgent::TickComponent(float DeltaTime, ELevelTick TickType, FActorCom
 	bDetermineLineOfSight();
 	PerformDetection();
 
-	const bool bIsVisible = WorldState->GetWorldState()["ThiefVisible"];
+	const bool bIsVisible = WorldState->GetState(GOAPFacts::ThiefVisible);
 	//UE_LOG(LogTemp, Warning, TEXT("IsVisible in Patrol: %s"), bIsVisible ? TEXT("true") : TEXT("false"));
 
 }
@@ -80,14 +80,10 @@ void UPatrolAgent::BeginPlay()
 	Goals.Add(NewObject<UChaseThief>(this));
 	Goals.Add(NewObject<UPatrolGoal>(this));
 	AvailableAction.Empty();
-	AvailableAction.Add(NewObject<UInvestigateAreaAction>(this));
-	AvailableAction.Add(NewObject<UMoveToWaypointAction>(this));
-	AvailableAction.Add(NewObject<UChaseThiefAction>(this));
+	AvailableAction.Add(GetMutableDefault<UInvestigateAreaAction>());
+	AvailableAction.Add(GetMutableDefault<UMoveToWaypointAction>());
+	AvailableAction.Add(GetMutableDefault<UChaseThiefAction>());
 	/*
-	// Initialize WorldState as a singleton
-	WorldState = UWorldState::GetInstance();
-	if(!WorldState)
-		UE_LOG(LogTemp, Log, TEXT("WorldState is null"));
 	Beliefs = NewObject<UPatrolAgentBeliefs>(this);  // Ensure it’s attached to the actor
 	if(!Beliefs)
 		UE_LOG(LogTemp, Log, TEXT("Beliefs is null")); 
@@ -196,27 +192,27 @@ void UPatrolAgent::PerformDetection()
 		ThiefPosition = TargetActor->GetActorLocation(); 
 
 		GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
-		UpdateBelief("ThiefVisible", true);
-		//WorldState->SetState("ThiefVisible", true);
+		UpdateBelief(GOAPFacts::ThiefVisible, true);
+		//WorldState->SetState(GOAPFacts::ThiefVisible, true);
 		UpdateBelief("ThiefVisible", ThiefPosition);
 		UpdateBelief("ThiefLastKnownPosition", ThiefPosition);
 		GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
 		GetBeliefs()->SetThiefVisible(true, ThiefPosition);
 		GetBeliefs()->SetThiefsLastKnownLocation(ThiefPosition);
 		GetAaiController()->SetFocus(TargetActor);
-		PlanActions();
+		PlanActionsIfDirty();
 	}
     else if (!bThiefVisible)
     {
     	//UE_LOG(LogTemp, Log, TEXT("Lost sight of Thief..."));
-    	UpdateBelief("ThiefVisible", false);
-    	WorldState->SetState("ThiefVisible", false);
+    	UpdateBelief(GOAPFacts::ThiefVisible, false);
+    	WorldState->SetState(GOAPFacts::ThiefVisible, false);
     	UpdateBelief("ThiefVisible", FVector::ZeroVector);
     	GetBeliefs()->SetThiefCurrentLocation(FVector::ZeroVector);
     	GetBeliefs()->SetThiefVisible(false, FVector::ZeroVector);
     	TargetActor = nullptr;
     	GetAaiController()->ClearFocus(EAIFocusPriority::Gameplay);
-    	PlanActions();
+    	PlanActionsIfDirty();
     }
 }
 
@@ -247,26 +243,26 @@ void UPatrolAgent::bDetermineLineOfSight()
 		ThiefPosition = TargetActor->GetActorLocation(); 
 
 		GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
-		UpdateBelief("ThiefVisible", true);
-		WorldState->SetState("ThiefVisible", true);
+		UpdateBelief(GOAPFacts::ThiefVisible, true);
+		WorldState->SetState(GOAPFacts::ThiefVisible, true);
 		UpdateBelief("ThiefVisible", ThiefPosition);
 		UpdateBelief("ThiefLastKnownPosition", ThiefPosition);
 		GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
 		GetBeliefs()->SetThiefVisible(true, ThiefPosition);
 		GetBeliefs()->SetThiefsLastKnownLocation(ThiefPosition);
 		GetAaiController()->SetFocus(TargetActor);
-		PlanActions();
+		PlanActionsIfDirty();
 	}
 	else
 	{
 		//UE_LOG(LogTemp, Log, TEXT("Lost sight of Thief..."));
-		UpdateBelief("ThiefVisible", false);
+		UpdateBelief(GOAPFacts::ThiefVisible, false);
 		UpdateBelief("ThiefVisible", FVector::ZeroVector);
 		GetBeliefs()->SetThiefCurrentLocation(FVector::ZeroVector);
 		GetBeliefs()->SetThiefVisible(false, FVector::ZeroVector);
 		TargetActor = nullptr;
 		GetAaiController()->ClearFocus(EAIFocusPriority::Gameplay);
-		PlanActions();
+		PlanActionsIfDirty();
 	}
 }
 
@@ -289,8 +285,8 @@ void UPatrolAgent::OnPerceptionUpdated(const TArray<AActor*>& Actors){
 	if (bThiefVisible)
 	{
 		GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
-		UpdateBelief("GuardVisible", true);
-		WorldState->SetState("ThiefVisible", true);
+		UpdateBelief(GOAPFacts::GuardVisible, true);
+		WorldState->SetState(GOAPFacts::ThiefVisible, true);
 		UpdateBelief("GuardPosition", ThiefPosition);
 		UpdateBelief("GuardLastKnownPosition", ThiefPosition);
 		GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
@@ -302,8 +298,8 @@ void UPatrolAgent::OnPerceptionUpdated(const TArray<AActor*>& Actors){
 	else
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Lost sight of agent..."));
-		UpdateBelief("GuardVisible", false);
-		WorldState->SetState("ThiefVisible", false);
+		UpdateBelief(GOAPFacts::GuardVisible, false);
+		WorldState->SetState(GOAPFacts::ThiefVisible, false);
 		UpdateBelief("GuardPosition", FVector::ZeroVector);
 		GetBeliefs()->SetThiefCurrentLocation(FVector::ZeroVector);
 		GetBeliefs()->SetThiefVisible(false, FVector::ZeroVector);
@@ -5,21 +5,22 @@
 
 UPatrolAgentBeliefs::UPatrolAgentBeliefs()
 {
-	BeliefsState.Add("ThiefVisible", false);
-	BeliefsState.Add("AtWaypoint", false);
+	BeliefsState.Set(GOAPFacts::ThiefVisible, false);
+	BeliefsState.Set(GOAPFacts::AtWaypoint, false);
+	BeliefsState.Set(GOAPFacts::ThiefLastKnownLocation, false);
 	BeliefsStateVectors.Add("ThiefLastKnownPosition", FVector::ZeroVector);
 	BeliefsStateVectors.Add("ThiefVisible", FVector::ZeroVector);
 }
 
 bool UPatrolAgentBeliefs::IsThiefVisible() const
 {
-	return BeliefsState.Contains("ThiefVisible") && BeliefsState["ThiefVisible"] &&
+	return BeliefsState.IsKnown(GOAPFacts::ThiefVisible) && BeliefsState.Get(GOAPFacts::ThiefVisible) &&
 		BeliefsStateVectors.Contains("ThiefPosition") && BeliefsStateVectors["ThiefPosition"] != FVector::Zero();
 }
 
 void UPatrolAgentBeliefs::SetThiefVisible(bool bVisibility, FVector bPosition)
 {
-	BeliefsState.Add("ThiefVisible", bVisibility);
+	BeliefsState.Set(GOAPFacts::ThiefVisible, bVisibility);
 }
 
 FVector UPatrolAgentBeliefs::GetThiefCurrentLocation() const
@@ -42,14 +43,5 @@ void UPatrolAgentBeliefs::SetThiefsLastKnownLocation(FVector Location)
 {
 	ThiefLastKnownLocation = Location;
 	BeliefsStateVectors.Add("ThiefLastKnownPosition", Location);
-}
-
-UPatrolAgentBeliefs* UPatrolAgentBeliefs::Clone()
-{
-	
-	UPatrolAgentBeliefs* Clone = NewObject<UPatrolAgentBeliefs>();
-	Clone->BeliefsState = this->BeliefsState;  
-	Clone->BeliefsStateVectors = this->BeliefsStateVectors;  
-	return Clone;
-	//return Super::Clone();
+	BeliefsState.Set(GOAPFacts::ThiefLastKnownLocation, !Location.IsZero());
 }
@@ -29,5 +29,4 @@ public:
 	void SetThiefCurrentLocation(FVector Location);
 	FVector GetThiefsLastKnownLocation() const;
 	void SetThiefsLastKnownLocation(FVector Location);
-	virtual UPatrolAgentBeliefs* Clone() override;
 };
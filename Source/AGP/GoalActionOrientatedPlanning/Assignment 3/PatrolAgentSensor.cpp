@@ -16,15 +16,13 @@ void UPatrolAgentSensor::UpdateBeliefsFromSensors()
 {
 	for (AActor* Actor : DetectedActors)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Scanning..."))
 		if (Actor->IsA(UThiefAgent::StaticClass()))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Saw thief..."))
 			ThiefPosition = Actor->GetActorLocation();
-			UpdateBelief("ThiefVisible", true);
-			WorldState->SetState("ThiefVisible", true);
+			UpdateBelief(GOAPFacts::ThiefVisible, true);
+			WorldState->SetState(GOAPFacts::ThiefVisible, true);
 			UpdateBelief("ThiefVisible", ThiefPosition);
-			UpdateBelief("ThiefLastKnownLocation", true);
+			UpdateBelief(GOAPFacts::ThiefLastKnownLocation, true);
 			GetTheOwner()->GetBeliefs()->SetThiefCurrentLocation(ThiefPosition);
 			GetTheOwner()->GetBeliefs()->SetThiefVisible(true, ThiefPosition);
 			GetTheOwner()->GetBeliefs()->SetThiefsLastKnownLocation(ThiefPosition);
@@ -32,10 +30,9 @@ void UPatrolAgentSensor::UpdateBeliefsFromSensors()
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Lost sight of thief..."))
 			ThiefPosition = FVector::ZeroVector;
-			WorldState->SetState("ThiefVisible", false);
-			UpdateBelief("ThiefVisible", false);
+			WorldState->SetState(GOAPFacts::ThiefVisible, false);
+			UpdateBelief(GOAPFacts::ThiefVisible, false);
 			UpdateBelief("ThiefVisible", FVector::ZeroVector);
 			GetTheOwner()->GetBeliefs()->SetThiefCurrentLocation(FVector::ZeroVector);
 			GetTheOwner()->GetBeliefs()->SetThiefVisible(false, FVector::ZeroVector);
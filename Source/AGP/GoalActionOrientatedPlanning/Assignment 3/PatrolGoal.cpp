@@ -9,13 +9,15 @@ UPatrolGoal::UPatrolGoal()
 {
 	// low priority
 	Priority = 1;
-	GoalState.Add("AtWaypoint", true); 
+	GoalState.Set(GOAPFacts::AtWaypoint, true); 
+	RelevanceFacts.Set(GOAPFacts::ThiefVisible, true);
+	RelevanceFacts.Set(GOAPFacts::ThiefLastKnownLocation, true);
 }
 
 bool UPatrolGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
 	/*
-	if (Beliefs.GetBeliefsState().Contains("AtWaypoint") && Beliefs.GetBeliefsState()["AtWaypoint"])
+	if (Beliefs.HasBelief(GOAPFacts::AtWaypoint) && Beliefs.GetBelief(GOAPFacts::AtWaypoint))
 	{
 		// Optionally, check if agent has patrolled through all waypoints
 		return true;  // Patrol goal is considered achieved when waypoints have been patrolled
@@ -28,8 +30,8 @@ bool UPatrolGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs&
 
 bool UPatrolGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-	return Beliefs.GetBeliefsState().Contains("ThiefVisible")
-	&& !Beliefs.GetBeliefsState()["ThiefVisible"]
+	return Beliefs.HasBelief(GOAPFacts::ThiefVisible)
+	&& !Beliefs.GetBelief(GOAPFacts::ThiefVisible)
 	&& Beliefs.GetBeliefsStateVectors().Contains("ThiefLastKnownPosition")
 	&& Beliefs.GetBeliefsStateVectors()["ThiefLastKnownPosition"] == FVector::ZeroVector;
 }
@@ -7,35 +7,40 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
+namespace
+{
+	constexpr FGOAPActionDescriptor RunAwayActionDescriptor = FGOAPActionDescriptor(0.0f)
+		.Requires(GOAPFacts::GoldTaken, true)
+		.Requires(GOAPFacts::ThiefVisible, false)
+		.Requires(GOAPFacts::Escaped, false)
+		.Causes(GOAPFacts::Escaped, true);
+}
+
 URunAwayAction::URunAwayAction()
 {
-	Preconditions.Add("GoldTaken", true);
-	Preconditions.Add("ThiefVisible", false);
-	Preconditions.Add("Escaped", false);
-	Effects.Add("Escaped", true);
+	SetDescriptor(RunAwayActionDescriptor);
 }
 
-bool URunAwayAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool URunAwayAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
 	return Super::IsActionPossible(WorldState,Beliefs );
 }
 
 
-void URunAwayAction::PerformAction()
+void URunAwayAction::PerformAction(FGOAPActionContext& Context) const
 { 
-	if (UThiefAgent* Agent = Cast<UThiefAgent>(GetOuter()))
+	if (UThiefAgent* Agent = Cast<UThiefAgent>(Context.Agent))
 	{
-		Character = Cast<ACharacter>(Agent->GetOwner());
-		UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+		UCharacterMovementComponent* MovementComp = Context.Character->GetCharacterMovement();
 		MovementComp->MaxWalkSpeed = Agent->GetRunSpeed();
 		FVector ExitVectorLocation(1490.0f, -250.0f, 460.0f);
 		Agent->MoveToLocation(ExitVectorLocation);
 	}
 }
 
-bool URunAwayAction::IsActionComplete() const
+bool URunAwayAction::IsActionComplete(const FGOAPActionContext& Context) const
 { 
-	if (UThiefAgent* Agent = Cast<UThiefAgent>(GetOuter()))
+	if (UThiefAgent* Agent = Cast<UThiefAgent>(Context.Agent))
 	{
 		FVector ExitVectorLocation(1490.0f, -250.0f, 460.0f);
 		FVector ThiefLocation = Agent->GetOwner()->GetActorLocation();
@@ -44,7 +49,7 @@ bool URunAwayAction::IsActionComplete() const
 	return false;
 }
 
-void URunAwayAction::ApplyEffects(UWorldState& WorldState)
+void URunAwayAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
+	Super::ApplyEffects(Context, WorldState);
 }
@@ -11,12 +11,14 @@ class UPatrolAgentBeliefs;
 URunAwayGoal::URunAwayGoal()
 {
 	Priority = 2;
-	GoalState.Add("Escaped", true);
+	GoalState.Set(GOAPFacts::Escaped, true);
+	RelevanceFacts.Set(GOAPFacts::GoldTaken, true);
+	RelevanceFacts.Set(GOAPFacts::Escaped, true);
 }
 
 bool URunAwayGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	const FVector PatrolAgentPosition = WorldState.VectorStates["ThiefAgentLocation"];
+	const FVector PatrolAgentPosition = WorldState.VectorStates.FindRef(TEXT("ThiefAgentLocation"));
 	const FVector ExitVectorLocation(1490.0f, -250.0f, 460.0f);
 	
 	return  FVector::Dist(PatrolAgentPosition, ExitVectorLocation) <= 100.0f;
@@ -24,8 +26,8 @@ bool URunAwayGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs&
 
 bool URunAwayGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-	return WorldState.GetWorldState().Contains("GoldTaken")
-	&& WorldState.GetWorldState()["GoldTaken"] == true
-	&& WorldState.GetWorldState().Contains("Escaped")
-	&& WorldState.GetWorldState()["Escaped"] == false;
+	return WorldState.HasState(GOAPFacts::GoldTaken)
+	&& WorldState.GetState(GOAPFacts::GoldTaken) == true
+	&& WorldState.HasState(GOAPFacts::Escaped)
+	&& WorldState.GetState(GOAPFacts::Escaped) == false;
 }
@@ -10,44 +10,48 @@
 
 class UCharacterMovementComponent;
 
+namespace
+{
+	constexpr FGOAPActionDescriptor StealActionDescriptor = FGOAPActionDescriptor(10.0f)
+		.Requires(GOAPFacts::GoldTaken, false)
+		.Requires(GOAPFacts::ThiefVisible, false)
+		.Causes(GOAPFacts::GoldTaken, true);
+}
+
 UStealAction::UStealAction()
 {
-	cost = 10;
-	Preconditions.Add("GoldTaken", false);
-	Preconditions.Add("ThiefVisible", false);
-	Effects.Add("GoldTaken", true);
+	SetDescriptor(StealActionDescriptor);
 }
 
-bool UStealAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UStealAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	return WorldState.GetWorldState()["GoldTaken"] == false && WorldState.GetWorldState()["ThiefVisible"] == false;
+	return WorldState.GetState(GOAPFacts::GoldTaken) == false && WorldState.GetState(GOAPFacts::ThiefVisible) == false;
 }
 
-void UStealAction::PerformAction()
+void UStealAction::PerformAction(FGOAPActionContext& Context) const
 { 
-	if (UThiefAgent* Agent = Cast<UThiefAgent>(GetOuter()))
+	if (UThiefAgent* Agent = Cast<UThiefAgent>(Context.Agent))
 	{
 		if(Agent->Gold != nullptr)
 		{
 			const FVector GoldLocation = Agent->GetGoldLocation();
 			//UE_LOG(LogTemp, Log, TEXT("Performining steal"))
-			Character = Cast<ACharacter>(Agent->GetOwner());
-			UCharacterMovementComponent* MovementComp = Character->GetCharacterMovement();
+			UCharacterMovementComponent* MovementComp = Context.Character->GetCharacterMovement();
 			MovementComp->MaxWalkSpeed = Agent->GetNormalSpeed();
 			Agent->GetAaiController()->MoveToLocation(GoldLocation , -1.0f);
 		}
 	}
 }
 
-bool UStealAction::IsActionComplete() const
+bool UStealAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	UThiefAgent* Agent = Cast<UThiefAgent>(GetOuter());
+	UThiefAgent* Agent = Cast<UThiefAgent>(Context.Agent);
 	AActor* actor = Agent->GetOwner();
 	float distance = FVector::Dist(actor->GetActorLocation(),Agent->GetGoldLocation());
 	return distance <= 250.0f;
 }
 
-void UStealAction::ApplyEffects(UWorldState& WorldState)
+void UStealAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
+	Super::ApplyEffects(Context, WorldState);
 }
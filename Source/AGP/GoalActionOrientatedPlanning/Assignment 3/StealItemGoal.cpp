@@ -6,17 +6,19 @@
 UStealItemGoal::UStealItemGoal()
 {
 	Priority = 2;
-	GoalState.Add("GoldenTaken", true);
+	GoalState.Set(GOAPFacts::GoldTaken, true);
+	RelevanceFacts.Set(GOAPFacts::GoldTaken, true);
+	RelevanceFacts.Set(GOAPFacts::ThiefVisible, true);
 }
 
 bool UStealItemGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	return WorldState.GetWorldState()["GoldTaken"];
+	return WorldState.GetState(GOAPFacts::GoldTaken);
 }
 
 bool UStealItemGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-	const bool bDosentHaveGold = !WorldState.GetWorldState()["GoldTaken"];
-	const bool bIsHidden = WorldState.GetWorldState()["ThiefVisible"] == false;
+	const bool bDosentHaveGold = !WorldState.GetState(GOAPFacts::GoldTaken);
+	const bool bIsHidden = WorldState.GetState(GOAPFacts::ThiefVisible) == false;
 	return bDosentHaveGold && bIsHidden ;
 }
@@ -24,22 +24,14 @@ void UThiefAgent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComp
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	WorldState->SetVectorState("ThiefAgentLocation", GetOwner()->GetActorLocation());
-	//WorldState->SetState("ThiefVisible", InLOS());
+	//WorldState->SetState(GOAPFacts::ThiefVisible, InLOS());
 	PerformDetection();
 
-	if(WorldState->GetWorldState()["ThiefVisible"])
-		PlanActions();
+	if(WorldState->GetState(GOAPFacts::ThiefVisible))
+		PlanActionsIfDirty();
 
-	
-	for (const UAction* Action : CurrentPlan)
-	{
-		if (Action)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Action Class Name: %s"), *Action->GetClass()->GetName());
-		}
-	}
 
-	const bool bIsVisible = WorldState->GetWorldState()["ThiefVisible"];
+	const bool bIsVisible = WorldState->GetState(GOAPFacts::ThiefVisible);
 	//UE_LOG(LogTemp, Warning, TEXT("IsVisible in thief: %s"), bIsVisible ? TEXT("true") : TEXT("false"));
 }
 
@@ -122,10 +114,10 @@ void UThiefAgent::PerformDetection()
             	DrawDebugLine(GetWorld(), StartLocation, HitActor->GetActorLocation(), FColor::Red, false, 1.0f);
                 GuardPosition = HitActor->GetActorLocation(); 
                 // Update beliefs
-                UpdateBelief("GuardVisible", true);
+                UpdateBelief(GOAPFacts::GuardVisible, true);
                 UpdateBelief("GuardPosition", GuardPosition);
                 UpdateBelief("GuardLastKnownPosition", GuardPosition);
-            	PlanActions();
+            	PlanActionsIfDirty();
                 bGuardVisible = true;
                 break; // Exit the loop if a patrol agent is detected
             }
@@ -136,9 +128,9 @@ void UThiefAgent::PerformDetection()
     {
         //UE_LOG(LogTemp, Warning, TEXT("No patrol agent detected within FOV."));
         // Update beliefs
-        UpdateBelief("GuardVisible", false);
+        UpdateBelief(GOAPFacts::GuardVisible, false);
         UpdateBelief("GuardPosition", FVector::ZeroVector);
-    	PlanActions();
+    	PlanActionsIfDirty();
     }
 }
 
@@ -211,14 +203,14 @@ void UThiefAgent::OnPerceptionUpdated(const TArray<AActor*>& Actors)
 	}
 	if (bGuardVisible)
 	{
-		UpdateBelief("GuardVisible", true);
+		UpdateBelief(GOAPFacts::GuardVisible, true);
 		UpdateBelief("GuardPosition", GuardPosition);
 		UpdateBelief("GuardLastKnownPosition", GuardPosition);
 		
 	}
 	else
 	{ 
-		UpdateBelief("GuardVisible", false);
+		UpdateBelief(GOAPFacts::GuardVisible, false);
 		UpdateBelief("GuardPosition", FVector::ZeroVector);
 	}
 }
@@ -231,10 +223,9 @@ void UThiefAgent::BeginPlay()
 	Goals.Add(NewObject<UEvadeDetectionGoal>(this));
 	Goals.Add(NewObject<URunAwayGoal>(this));
 
-	AvailableAction.Add(NewObject<UStealAction>(this));
-	AvailableAction.Add(NewObject<UHideAction>(this));
-	AvailableAction.Add(NewObject<URunAwayAction>(this));
-	WorldState = UWorldState::GetInstance();
+	AvailableAction.Add(GetMutableDefault<UStealAction>());
+	AvailableAction.Add(GetMutableDefault<UHideAction>());
+	AvailableAction.Add(GetMutableDefault<URunAwayAction>());
 	Beliefs = NewObject<UThiefAgentBeliefs>(this);
 	Sensor = NewObject<UThiefAgentSesnor>(GetOwner(), UThiefAgentSesnor::StaticClass(), TEXT("Sensor"));
 	Sensor->SetOwnerAgent(this);
@@ -5,14 +5,14 @@
 
 bool UThiefAgentBeliefs::IsPatrolAgentVisible() const
 {
-	return BeliefsState.Contains("GuardVisible") && BeliefsState["GuardVisible"] &&
+	return BeliefsState.IsKnown(GOAPFacts::GuardVisible) && BeliefsState.Get(GOAPFacts::GuardVisible) &&
 	BeliefsStateVectors.Contains("GuardPosition") && BeliefsStateVectors["GuardPosition"] != FVector::Zero();
 }
 
 void UThiefAgentBeliefs::SetPatrolAgentVisible(bool bVisibility , FVector bPosition)
 {
-	BeliefsState.Add("GuardVisible", bVisibility);
-	if(BeliefsState["GuardVisible"])
+	BeliefsState.Set(GOAPFacts::GuardVisible, bVisibility);
+	if(BeliefsState.Get(GOAPFacts::GuardVisible))
 	{
 		BeliefsStateVectors["GuardPosition"] = bPosition;
 		PatrolAgentCurrentLocation = bPosition;
@@ -42,17 +42,9 @@ void UThiefAgentBeliefs::SetThiefsLastKnownLocation(FVector Location)
 	PatrolAgentLastKnownLocation = Location;
 }
 
-UThiefAgentBeliefs* UThiefAgentBeliefs::Clone()
-{ 
-	UThiefAgentBeliefs* Clone = NewObject<UThiefAgentBeliefs>();
-	Clone->BeliefsState = this->BeliefsState;  
-	Clone->BeliefsStateVectors = this->BeliefsStateVectors;  
-	return Clone; 
-}
-
 UThiefAgentBeliefs::UThiefAgentBeliefs()
 { 
-	BeliefsState.Add("GuardVisible", false);
+	BeliefsState.Set(GOAPFacts::GuardVisible, false);
 	BeliefsStateVectors.Add("GuardPosition", FVector::ZeroVector);
 	BeliefsStateVectors.Add("GuardLastKnownPosition", FVector::ZeroVector);
 }
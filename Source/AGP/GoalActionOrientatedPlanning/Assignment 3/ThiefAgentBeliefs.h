@@ -28,7 +28,6 @@ public:
 	void SetPatrolAgentCurrentLocation(FVector Location);
 	FVector GetThiefsLastKnownLocation() const;
 	void SetThiefsLastKnownLocation(FVector Location);
-	virtual UThiefAgentBeliefs* Clone() override;
 
 protected:
 	UThiefAgentBeliefs();
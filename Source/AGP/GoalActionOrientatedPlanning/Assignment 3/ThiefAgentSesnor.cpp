@@ -18,14 +18,14 @@ void UThiefAgentSesnor::UpdateBeliefsFromSensors()
 		if (Actor->IsA(UPatrolAgent::StaticClass()))
 		{ 
 			GuardPosition = Actor->GetActorLocation();
-			UpdateBelief("GuardVisib le", true);
+			UpdateBelief(GOAPFacts::GuardVisible, true);
 			UpdateBelief("GuardPosition", GuardPosition);
 			UpdateBelief("GuardLastKnownPosition", GuardPosition);
 		}
 		else
 		{ 
 			GuardPosition = FVector::ZeroVector;
-			UpdateBelief("GuardVisible", false);
+			UpdateBelief(GOAPFacts::GuardVisible, false);
 			UpdateBelief("GuardPosition", GuardPosition);
 		}
 	}
@@ -5,48 +5,63 @@
 #include "EnemyAgentBeliefs.h"
 #include "AGP/Characters/EnemyCharacter.h"
 
+namespace
+{
+	constexpr FGOAPActionDescriptor AttackActionDescriptor = FGOAPActionDescriptor(5.0f)
+		.Requires(GOAPFacts::TargetSpotted, true)
+		.Requires(GOAPFacts::WithinRange, true)
+		.Requires(GOAPFacts::InDangerOfDeath, false)
+		.Requires(GOAPFacts::HasFullHealth, false)
+		.Causes(GOAPFacts::AttackingTarget, true);
+}
+
 UAttackAction::UAttackAction()
 {
-	cost = 5.0f;
-	Effects.Add("AttackingTarget", true);
+	SetDescriptor(AttackActionDescriptor);
 }
 
-bool UAttackAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UAttackAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"];
-	const bool bWithinFiringRange = EnemyAgent->GetBeliefs()->GetBeliefsState()["WithinRange"];
-	const bool bNotInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] == false;
-	const bool bDoesNotHaveHealthToTankWhileCharging = EnemyAgent->GetBeliefs()->GetBeliefsState()["HasFullHealth"] == false;
+	const bool bTargetSpotted = Beliefs.GetBelief(GOAPFacts::TargetSpotted);
+	const bool bWithinFiringRange = Beliefs.GetBelief(GOAPFacts::WithinRange);
+	const bool bNotInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == false;
+	const bool bDoesNotHaveHealthToTankWhileCharging = Beliefs.GetBelief(GOAPFacts::HasFullHealth) == false;
 	return bDoesNotHaveHealthToTankWhileCharging && bTargetSpotted && bWithinFiringRange && bNotInDangerOfDeath;
 }
 
-void UAttackAction::PerformAction()
+float UAttackAction::GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const float Cost = Super::GetCost(WorldState, Beliefs);
+	const UEnemyAgentBeliefs* EnemyBeliefs = Cast<UEnemyAgentBeliefs>(&Beliefs);
+	if (!EnemyBeliefs) return Cost;
+
+	// An enemy that is low on ammo will have to stop and reload part way through
+	return Cost + (1.0f - EnemyBeliefs->GetAmmoPercentage()) * 2.0f;
+}
+
+void UAttackAction::PerformAction(FGOAPActionContext& Context) const
 {
-	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter());
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
 	EnemyCharacter->TickEngageStationary()();
-	UE_LOG(LogTemp, Warning, TEXT("Engaging in defensive posture...")); 
 }
 
-bool UAttackAction::IsActionComplete() const
+bool UAttackAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	const bool bNoTarget = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"] == false;
-	const bool bOutOfRange = EnemyAgent->GetBeliefs()->GetBeliefsState()["WithinRange"] == false;
-	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] == true;
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent); 
+	const bool bNoTarget = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::TargetSpotted) == false;
+	const bool bOutOfRange = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::WithinRange) == false;
+	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::InDangerOfDeath) == true;
 	
 	if (bNoTarget || bOutOfRange|| bInDangerOfDeath)
 	{
 		// Reset AttackingTarget to false
-		EnemyAgent->GetBeliefs()->GetBeliefsState()["AttackingTarget"] = false;
+		EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::AttackingTarget, false);
 		return true;
 	}
 	return false;
 }
 
-void UAttackAction::ApplyEffects(UWorldState& WorldState)
+void UAttackAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	WorldState.GetWorldState()["AllEnemiesEliminated"] = true;
+	Super::ApplyEffects(Context, WorldState);
 }
@@ -2,49 +2,66 @@
 #include "AGP/GoalActionOrientatedPlanning/ChargeAttackAction.h"
 
 #include "EnemyAgent.h"
+#include "EnemyAgentBeliefs.h"
 #include "AGP/Characters/EnemyCharacter.h"
 
+namespace
+{
+	constexpr FGOAPActionDescriptor ChargeAttackActionDescriptor = FGOAPActionDescriptor(7.0f)
+		.Requires(GOAPFacts::TargetSpotted, true)
+		.Requires(GOAPFacts::WithinRange, true)
+		.Requires(GOAPFacts::InDangerOfDeath, false)
+		.Requires(GOAPFacts::HasFullHealth, true)
+		.Causes(GOAPFacts::AttackingTarget, true);
+}
+
 UChargeAttackAction::UChargeAttackAction()
 {
-	cost = 7.0f;
-	Effects.Add("AttackingTarget", true);
+	SetDescriptor(ChargeAttackActionDescriptor);
 }
 
-bool UChargeAttackAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UChargeAttackAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"];
-	const bool bWithinFiringRange = EnemyAgent->GetBeliefs()->GetBeliefsState()["WithinRange"];
-	const bool bNotInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] == false;
-	const bool bHasHealthToTankWhileCharging = EnemyAgent->GetBeliefs()->GetBeliefsState()["HasFullHealth"] == true;
+	const bool bTargetSpotted = Beliefs.GetBelief(GOAPFacts::TargetSpotted);
+	const bool bWithinFiringRange = Beliefs.GetBelief(GOAPFacts::WithinRange);
+	const bool bNotInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == false;
+	const bool bHasHealthToTankWhileCharging = Beliefs.GetBelief(GOAPFacts::HasFullHealth) == true;
 	return bTargetSpotted && bWithinFiringRange && bNotInDangerOfDeath && bHasHealthToTankWhileCharging;
 }
 
-void UChargeAttackAction::PerformAction()
+float UChargeAttackAction::GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const float Cost = Super::GetCost(WorldState, Beliefs);
+	const UEnemyAgentBeliefs* EnemyBeliefs = Cast<UEnemyAgentBeliefs>(&Beliefs);
+	if (!EnemyBeliefs) return Cost;
+
+	// The further there is to charge, the longer the enemy is exposed
+	return Cost + EnemyBeliefs->GetDistanceToTarget() / 1000.0f;
+}
+
+void UChargeAttackAction::PerformAction(FGOAPActionContext& Context) const
 {
-	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter());
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
 	EnemyCharacter->TickEngage();
-	UE_LOG(LogTemp, Warning, TEXT("Engaging in offensive posture...")); 
 }
 
-bool UChargeAttackAction::IsActionComplete() const
+bool UChargeAttackAction::IsActionComplete(const FGOAPActionContext& Context) const
 {  
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	const bool bNoTarget = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"] == false;
-	const bool bOutOfRange = EnemyAgent->GetBeliefs()->GetBeliefsState()["WithinRange"] == false;
-	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] == true;
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent); 
+	const bool bNoTarget = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::TargetSpotted) == false;
+	const bool bOutOfRange = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::WithinRange) == false;
+	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::InDangerOfDeath) == true;
 	
 	if (bNoTarget || bOutOfRange|| bInDangerOfDeath)
 	{
 		// Reset AttackingTarget to false
-		EnemyAgent->GetBeliefs()->GetBeliefsState()["AttackingTarget"] = false;
+		EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::AttackingTarget, false);
 		return true;
 	}
 	return false;
 }
 
-void UChargeAttackAction::ApplyEffects(UWorldState& WorldState)
+void UChargeAttackAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
-	WorldState.GetWorldState()["AllEnemiesEliminated"] = true;
+	Super::ApplyEffects(Context, WorldState);
 }
@@ -7,20 +7,40 @@
 
 UEliminateEnemyGoal::UEliminateEnemyGoal()
 {
-    GoalState.Add("AllEnemiesEliminated", true);
+    // No single action eliminates every enemy, so the plan is to keep attacking until they are
+    GoalState.Set(GOAPFacts::AttackingTarget, true);
     Priority = 10; // Higher priority than stay alive
+    RelevanceFacts.Set(GOAPFacts::AllEnemiesEliminated, true);
+    UtilityFacts.Set(GOAPFacts::TargetSpotted, true);
+    UtilityFacts.Set(GOAPFacts::HasFullHealth, true);
 }
 
 bool UEliminateEnemyGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 { 
-    const bool bAllEnemiesEliminated = WorldState.GetWorldState()["AllEnemiesEliminated"];
+    const bool bAllEnemiesEliminated = WorldState.GetState(GOAPFacts::AllEnemiesEliminated);
     return bAllEnemiesEliminated;
 }
 
 bool UEliminateEnemyGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-    const bool bAllEnemiesEliminated = WorldState.GetWorldState()["AllEnemiesEliminated"];
+    const bool bAllEnemiesEliminated = WorldState.GetState(GOAPFacts::AllEnemiesEliminated);
     return !bAllEnemiesEliminated;
 }
 
+float UEliminateEnemyGoal::CalculateUtility(const FGOAPFactSet& Facts) const
+{
+    // A target in sight is worth more than one that has to be found, and an enemy at full health can afford to push.
+    // Neither takes it past staying alive.
+    float Utility = Priority;
+    if (Facts.Get(GOAPFacts::TargetSpotted))
+    {
+        Utility += 1.0f;
+    }
+    if (Facts.Get(GOAPFacts::HasFullHealth))
+    {
+        Utility += 0.5f;
+    }
+    return Utility;
+}
+
 
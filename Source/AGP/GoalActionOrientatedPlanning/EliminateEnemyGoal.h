@@ -16,4 +16,5 @@ class AGP_API UEliminateEnemyGoal : public UGoal
 	UEliminateEnemyGoal();
 	virtual bool IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
 	virtual bool IsGoalRelevant(const UWorldState& WorldState,  UBeliefs& Beliefs) const;
+	virtual float CalculateUtility(const FGOAPFactSet& Facts) const override;
 };
@@ -25,26 +25,12 @@ void UEnemyAgent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComp
 
 	/*
 	UE_LOG(LogTemp, Warning, TEXT("Beliefs - TargetSpotted: %s, WithinRange: %s"),
-	   GetBeliefs()->GetBeliefsState()["TargetSpotted"] ? TEXT("true") : TEXT("false"),
-	   GetBeliefs()->GetBeliefsState()["WithinRange"] ? TEXT("true") : TEXT("false"));
+	   GetBeliefs()->GetBelief(GOAPFacts::TargetSpotted) ? TEXT("true") : TEXT("false"),
+	   GetBeliefs()->GetBelief(GOAPFacts::WithinRange) ? TEXT("true") : TEXT("false"));
 	*/
 
-	//Display current goal, action and amount of actions in enemy agent's current plan
-	if (CurrentGoal)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Current Goal: %s"), *CurrentGoal->GetName());
-	}
-	if (CurrentPlan.Num() > 0 && CurrentPlan[0])
-	{
-		for(int i = 0; i <CurrentPlan.Num(); i++)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Current Action: %s"), *CurrentPlan[i]->GetName());
-		}
-	} 
+	// The current goal, the plan and the beliefs flipping are recorded in the GOAP trace (see GOAP.DumpTrace)
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	UE_LOG(LogTemp, Warning, TEXT("Sensed character detected: %s"), 
-	   GetEnemyCharacterComponent()->GetSensedCharacter() != nullptr ? TEXT("true") : TEXT("false"));
 }
 
 void UEnemyAgent::PerformAction()
@@ -60,6 +46,7 @@ bool UEnemyAgent::PlanActions()
 UEnemyAgent::UEnemyAgent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
+	BlackboardTeam = TEXT("Enemies");
 }
 
 void UEnemyAgent::BeginPlay()
@@ -69,14 +56,17 @@ void UEnemyAgent::BeginPlay()
 	Goals.Add(NewObject<UEliminateEnemyGoal>(this));
 	Goals.Add(NewObject<UStayAliveGoal>(this)); 
 	AvailableAction.Empty();
-	AvailableAction.Add(NewObject<UChargeAttackAction>(this));
-	AvailableAction.Add(NewObject<UAttackAction>(this));
-	AvailableAction.Add(NewObject<UAdvanceAction>(this));
-	AvailableAction.Add(NewObject<UPatrolAction>(this));
-	AvailableAction.Add(NewObject<UHealAction>(this));
-	AvailableAction.Add(NewObject<URetreatAction>(this));  
+	AvailableAction.Add(GetMutableDefault<UChargeAttackAction>());
+	AvailableAction.Add(GetMutableDefault<UAttackAction>());
+	AvailableAction.Add(GetMutableDefault<UAdvanceAction>());
+	AvailableAction.Add(GetMutableDefault<UPatrolAction>());
+	AvailableAction.Add(GetMutableDefault<UHealAction>());
+	AvailableAction.Add(GetMutableDefault<URetreatAction>());  
+	// Only used for the roles the enemy's squad gives it, no goal of the enemy's own needs them
+	AvailableAction.Add(GetMutableDefault<UTakeCoverAction>());
+	AvailableAction.Add(GetMutableDefault<USuppressPlayerAction>());
+	AvailableAction.Add(GetMutableDefault<UFlankAction>());
 	Beliefs = NewObject<UEnemyAgentBeliefs>(this);
-	WorldState = UWorldState::GetInstance();
 	EnemyCharacterComponent = Cast<AEnemyCharacter>(GetOuter());
 	if(EnemyCharacterComponent)
 	{
@@ -123,22 +113,21 @@ void UEnemyAgent::ManageSensedCharacters()
 		if (const APlayerCharacter* Character = EnemyCharacterComponent->GetSensedCharacter())
 		{
 			const float Distance = FVector::Dist(EnemyCharacterComponent->GetActorLocation(), Character->GetActorLocation());
-			UE_LOG(LogTemp, Warning, TEXT("Distance: %f"), Distance);
 			const bool bWithinRange = Distance <= 10000.0f;
 
 			// Now we're modifying the actual belief map
-			Beliefs->GetBeliefsState()["WithinRange"] = bWithinRange;
-			Beliefs->GetBeliefsState()["TargetSpotted"] = true;
+			Beliefs->SetBelief(GOAPFacts::WithinRange, bWithinRange);
+			Beliefs->SetBelief(GOAPFacts::TargetSpotted, true);
 			Beliefs->GetBeliefsStateVectors()["TargetPosition"] = Character->GetActorLocation();
 			Beliefs->GetBeliefsStateVectors()["LastKnownTargetPosition"] = Character->GetActorLocation();
 		}
 		else
 		{
-			Beliefs->GetBeliefsState()["TargetSpotted"] = false;
-			Beliefs->GetBeliefsState()["WithinRange"] = false;
+			Beliefs->SetBelief(GOAPFacts::TargetSpotted, false);
+			Beliefs->SetBelief(GOAPFacts::WithinRange, false);
 			Beliefs->GetBeliefsStateVectors()["TargetPosition"] = FVector::ZeroVector;
 		}
-		PlanActions();
+		PlanActionsIfDirty();
 	}
 }
 
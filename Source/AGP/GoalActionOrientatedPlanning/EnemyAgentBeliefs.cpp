@@ -11,15 +11,20 @@ class AEnemyCharacter;
 
 UEnemyAgentBeliefs::UEnemyAgentBeliefs()
 {
-	BeliefsState.Emplace("TargetSpotted", false);
-	BeliefsState.Emplace("AttackingTarget", false);
-	BeliefsState.Emplace("InDangerOfDeath", false);
-	BeliefsState.Emplace("IsHealing", false);
-	BeliefsState.Emplace("HasFullHealth", true);
-	BeliefsState.Emplace("WithinRange", false);
-	BeliefsState.Emplace("SafeDistanceToHeal", false);
+	BeliefsState.Set(GOAPFacts::TargetSpotted, false);
+	BeliefsState.Set(GOAPFacts::AttackingTarget, false);
+	BeliefsState.Set(GOAPFacts::InDangerOfDeath, false);
+	BeliefsState.Set(GOAPFacts::IsHealing, false);
+	BeliefsState.Set(GOAPFacts::HasFullHealth, true);
+	BeliefsState.Set(GOAPFacts::WithinRange, false);
+	BeliefsState.Set(GOAPFacts::SafeDistanceToHeal, false);
+	BeliefsState.Set(GOAPFacts::InCover, false);
+	BeliefsState.Set(GOAPFacts::SuppressingTarget, false);
+	BeliefsState.Set(GOAPFacts::FlankingTarget, false);
 	BeliefsStateVectors.Emplace("TargetPosition", FVector::ZeroVector);
 	BeliefsStateVectors.Emplace("LastKnownTargetPosition", FVector::ZeroVector);
+	// Where the enemy's squad wants it for its role, if it is in a squad
+	BeliefsStateVectors.Emplace("SquadPosition", FVector::ZeroVector);
 }
 
 void UEnemyAgentBeliefs::SetCurrentHealthPercentage(const float percentage)
@@ -38,7 +43,7 @@ bool UEnemyAgentBeliefs::bIsClose() const
 	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter());
 	float Distance = FVector::Dist(EnemyCharacter->GetActorLocation(), EnemyAgent->GetBeliefs()->GetBeliefsStateVectors()["LastKnownTargetPosition"]);
 	bool bSafeDistance = Distance <= EnemyCharacter->GetNoiseSenitivity();
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["SafeDistanceToHeal"] = bSafeDistance;
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::SafeDistanceToHeal, bSafeDistance);
 	return bSafeDistance;
 }
 
@@ -47,8 +52,7 @@ bool UEnemyAgentBeliefs::bInDangerOfDeath() const
 	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
 	const float HealthPercentage = EnemyAgent->GetHealthComponent()->GetCurrentHealthPercentage();
 	const bool bInDangerOfDeath = HealthPercentage <= Cast<AEnemyCharacter>(EnemyAgent->GetOuter())->GetAggressionClamped();
-	UE_LOG(LogTemp, Log, TEXT("Enemy Aggression Clamped: %f"),Cast<AEnemyCharacter>(GetOuter()->GetOuter())->GetAggressionClamped() );
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] = bInDangerOfDeath;
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::InDangerOfDeath, bInDangerOfDeath);
 	return bInDangerOfDeath;
 }
 
@@ -57,7 +61,7 @@ bool UEnemyAgentBeliefs::bHasFullHealth() const
 	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
 	float HealthPercentage = EnemyAgent->GetHealthComponent()->GetCurrentHealthPercentage();
 	bool bHasFullHealth = HealthPercentage >=1.0f;
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["HasFullHealth"] = bHasFullHealth;
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::HasFullHealth, bHasFullHealth);
 	return bHasFullHealth;
 }
 
@@ -74,15 +78,21 @@ void UEnemyAgentBeliefs::UpdateBeliefs()
 	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter());
 	const float HealthPercentage = EnemyAgent->GetHealthComponent()->GetCurrentHealthPercentage();
 	bool bHasFullHealth = HealthPercentage >=1.0f;
-	GetBeliefsState()["HasFullHealth"] = bHasFullHealth;
+	SetBelief(GOAPFacts::HasFullHealth, bHasFullHealth);
 
 	const bool bInDangerOfDeath = HealthPercentage <= 0.61f;
-	GetBeliefsState()["InDangerOfDeath"] = bInDangerOfDeath;
+	SetBelief(GOAPFacts::InDangerOfDeath, bInDangerOfDeath);
 	
-	float Distance = FVector::Dist(EnemyCharacter->GetActorLocation(), GetBeliefsStateVectors()["LastKnownTargetPosition"]);
+	const FVector LastKnownTargetPosition = GetBeliefsStateVectors()["LastKnownTargetPosition"];
+	float Distance = FVector::Dist(EnemyCharacter->GetActorLocation(), LastKnownTargetPosition);
 	bool bSafeDistance = Distance <= 300.0f;
-	GetBeliefsState()["SafeDistanceToHeal"] = bSafeDistance;
+	SetBelief(GOAPFacts::SafeDistanceToHeal, bSafeDistance);
 
+	DistanceToTarget = LastKnownTargetPosition != FVector::ZeroVector ? Distance : 0.0f;
+	const FVector SquadPosition = GetBeliefsStateVectorsConst().FindRef("SquadPosition");
+	DistanceToSquadPosition = SquadPosition != FVector::ZeroVector ?
+		FVector::Dist(EnemyCharacter->GetActorLocation(), SquadPosition) : 0.0f;
+	AmmoPercentage = EnemyCharacter->GetAmmoPercentage();
 }
 
 
@@ -95,3 +105,18 @@ AActor* UEnemyAgentBeliefs::GetTarget() const
 {
 	return Target;
 }
+
+float UEnemyAgentBeliefs::GetDistanceToTarget() const
+{
+	return DistanceToTarget;
+}
+
+float UEnemyAgentBeliefs::GetDistanceToSquadPosition() const
+{
+	return DistanceToSquadPosition;
+}
+
+float UEnemyAgentBeliefs::GetAmmoPercentage() const
+{
+	return AmmoPercentage;
+}
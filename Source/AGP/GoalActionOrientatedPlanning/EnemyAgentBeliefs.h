@@ -21,7 +21,13 @@ protected:
 	float CurrentHealthPercentage;
 	UPROPERTY()
 	AActor* Target;
-	
+
+	// Worked out once a tick in UpdateBeliefs, so that action costs can read them without touching the world.
+	// The distances are 0 while the position they are to is unknown.
+	float DistanceToTarget = 0.0f;
+	float DistanceToSquadPosition = 0.0f;
+	float AmmoPercentage = 1.0f;
+
 
 public:
 	void SetCurrentHealthPercentage(const float percentage);
@@ -34,4 +40,19 @@ public:
 
 	void SetTarget(AActor* target);
 	AActor* GetTarget() const;
+
+	/**
+	 * @return The distance to where the target was last seen, as of the last UpdateBeliefs.
+	 */
+	float GetDistanceToTarget() const;
+
+	/**
+	 * @return The distance to where the enemy's squad wants it, as of the last UpdateBeliefs.
+	 */
+	float GetDistanceToSquadPosition() const;
+
+	/**
+	 * @return The fraction of the magazine that is left, as of the last UpdateBeliefs.
+	 */
+	float GetAmmoPercentage() const;
 };
\ No newline at end of file
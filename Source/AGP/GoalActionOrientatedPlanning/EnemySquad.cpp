@@ -0,0 +1,320 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AGP/GoalActionOrientatedPlanning/EnemySquad.h"
+
+#include "AdvanceAction.h"
+#include "EnemyAgent.h"
+#include "EnemyAgentBeliefs.h"
+#include "FlankAction.h"
+#include "SuppressPlayerAction.h"
+#include "GOAP base/GOAPTrace.h"
+
+namespace
+{
+	/**
+	 * A step the squad as a whole can take, and the role of the member that takes it. The facts are the squad's, where
+	 * a fact holds if it holds for any member.
+	 */
+	struct FSquadTactic
+	{
+		ESquadRole Role;
+		FGOAPActionDescriptor Descriptor;
+	};
+
+	constexpr FSquadTactic SquadTactics[] =
+	{
+		// Pin the target down so that it can't turn on anyone going round it
+		{ ESquadRole::Suppress, FGOAPActionDescriptor(1.0f)
+			.Requires(GOAPFacts::TargetSpotted, true)
+			.Causes(GOAPFacts::SuppressingTarget, true) },
+		{ ESquadRole::Flank, FGOAPActionDescriptor(2.0f)
+			.Requires(GOAPFacts::SuppressingTarget, true)
+			.Causes(GOAPFacts::FlankingTarget, true) },
+		// Attack from the side while the target is pinned down
+		{ ESquadRole::Advance, FGOAPActionDescriptor(1.0f)
+			.Requires(GOAPFacts::FlankingTarget, true)
+			.Causes(GOAPFacts::AttackingTarget, true) },
+		// Rush the target with nobody covering, which is all the squad can do until it has seen the target
+		{ ESquadRole::Advance, FGOAPActionDescriptor(6.0f)
+			.Causes(GOAPFacts::AttackingTarget, true) },
+	};
+
+	constexpr int32 MaxSquadSearchNodes = 64;
+
+	/**
+	 * The search hands plans back as actions, so each tactic is represented by the action its role starts with.
+	 */
+	UAction* GetRoleAction(ESquadRole Role)
+	{
+		switch (Role)
+		{
+		case ESquadRole::Suppress: return GetMutableDefault<USuppressPlayerAction>();
+		case ESquadRole::Flank: return GetMutableDefault<UFlankAction>();
+		case ESquadRole::Advance: return GetMutableDefault<UAdvanceAction>();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Will forget everything the member did for its role.
+	 */
+	void ResetRoleBeliefs(UEnemyAgentBeliefs& Beliefs)
+	{
+		Beliefs.SetBelief(GOAPFacts::InCover, false);
+		Beliefs.SetBelief(GOAPFacts::SuppressingTarget, false);
+		Beliefs.SetBelief(GOAPFacts::FlankingTarget, false);
+		Beliefs.GetBeliefsStateVectors().Add("SquadPosition", FVector::ZeroVector);
+	}
+}
+
+UEnemySquad::UEnemySquad()
+{
+	const TPair<ESquadRole, const TCHAR*> Roles[] =
+	{
+		{ ESquadRole::Suppress, TEXT("SuppressGoal") },
+		{ ESquadRole::Flank, TEXT("FlankGoal") },
+		{ ESquadRole::Advance, TEXT("AdvanceGoal") },
+	};
+	for (const TPair<ESquadRole, const TCHAR*>& Role : Roles)
+	{
+		USquadRoleGoal* RoleGoal = CreateDefaultSubobject<USquadRoleGoal>(Role.Value);
+		RoleGoal->SetRole(Role.Key);
+		RoleGoals.Add(RoleGoal);
+	}
+}
+
+void UEnemySquad::AddMember(UEnemyAgent* Agent)
+{
+	if (!Agent || Members.ContainsByPredicate([Agent](const FEnemySquadMember& Member)
+	{
+		return Member.Agent == Agent;
+	})) return;
+
+	FEnemySquadMember& Member = Members.AddDefaulted_GetRef();
+	Member.Agent = Agent;
+	// The roles are handed out again with the new member
+	bHasPlanned = false;
+}
+
+bool UEnemySquad::Tick()
+{
+	Members.RemoveAll([](const FEnemySquadMember& Member)
+	{
+		return !IsValid(Member.Agent) || !IsValid(Member.Agent->GetOwner()) || !Member.Agent->GetBeliefs();
+	});
+	if (Members.Num() < 2)
+	{
+		Disband();
+		return false;
+	}
+
+	// The squad knows what any of its members knows
+	FGOAPFactSet Facts;
+	Facts.Set(GOAPFacts::TargetSpotted, false);
+	bool bRolesOutOfDate = !bHasPlanned;
+	for (const FEnemySquadMember& Member : Members)
+	{
+		const UEnemyAgentBeliefs* Beliefs = Member.Agent->GetBeliefs();
+		if (Beliefs->GetBelief(GOAPFacts::TargetSpotted))
+		{
+			Facts.Set(GOAPFacts::TargetSpotted, true);
+			TargetLocation = Beliefs->GetBeliefsStateVectorsConst().FindRef("TargetPosition");
+		}
+		if (IsAbleToTakeRole(Member) != Member.bWasAble)
+		{
+			bRolesOutOfDate = true;
+		}
+	}
+
+	if (bRolesOutOfDate || Facts != PlannedFacts)
+	{
+		PlannedFacts = Facts;
+		bHasPlanned = true;
+		TArray<ESquadRole> Roles;
+		if (PlanRoles(Facts, Roles))
+		{
+			AssignRoles(Roles);
+		}
+		else
+		{
+			Disband();
+		}
+	}
+
+	UpdatePositions(Facts.Get(GOAPFacts::TargetSpotted));
+	return true;
+}
+
+bool UEnemySquad::PlanRoles(const FGOAPFactSet& Facts, TArray<ESquadRole>& OutRoles)
+{
+	TArray<FGOAPActionData, TInlineAllocator<UE_ARRAY_COUNT(SquadTactics)>> Tactics;
+	for (const FSquadTactic& Tactic : SquadTactics)
+	{
+		FGOAPActionData& TacticData = Tactics.AddDefaulted_GetRef();
+		TacticData.Action = GetRoleAction(Tactic.Role);
+		TacticData.Preconditions = Tactic.Descriptor.Preconditions;
+		TacticData.Effects = Tactic.Descriptor.Effects;
+		TacticData.Cost = Tactic.Descriptor.Cost;
+	}
+
+	FGOAPFactSet GoalState;
+	GoalState.Set(GOAPFacts::AttackingTarget, true);
+
+	TArray<UAction*> Plan;
+	if (!UPlanner::SearchPlan(Facts, GoalState, Tactics, Tactics.Num(), MaxSquadSearchNodes, SearchBuffers, Plan))
+	{
+		return false;
+	}
+
+	OutRoles.Reset();
+	for (const UAction* Action : Plan)
+	{
+		for (const ESquadRole Role : { ESquadRole::Suppress, ESquadRole::Flank, ESquadRole::Advance })
+		{
+			if (Action == GetRoleAction(Role))
+			{
+				OutRoles.Add(Role);
+				break;
+			}
+		}
+	}
+
+	const FName TraceName = GetFName();
+	FGOAPTrace::Record(EGOAPTraceEvent::PlanCommitted, TraceName, GetClass()->GetFName(), OutRoles.Num());
+	for (int32 Index = 0; Index < OutRoles.Num(); Index++)
+	{
+		FGOAPTrace::Record(EGOAPTraceEvent::PlanStep, TraceName, UEnum::GetValueAsName(OutRoles[Index]), Index);
+	}
+	return OutRoles.Num() > 0;
+}
+
+void UEnemySquad::AssignRoles(TConstArrayView<ESquadRole> Roles)
+{
+	TArray<FEnemySquadMember*, TInlineAllocator<8>> AbleMembers;
+	for (FEnemySquadMember& Member : Members)
+	{
+		Member.bWasAble = IsAbleToTakeRole(Member);
+		if (Member.bWasAble)
+		{
+			AbleMembers.Add(&Member);
+		}
+		else
+		{
+			ClearRole(Member);
+		}
+	}
+
+	// One member can't work together with anyone, so it is left to its own goals.
+	if (AbleMembers.Num() < 2)
+	{
+		for (FEnemySquadMember* Member : AbleMembers)
+		{
+			ClearRole(*Member);
+		}
+		return;
+	}
+
+	// The members furthest from the target take the first steps, which hold back, and the nearest ones advance.
+	if (TargetLocation != FVector::ZeroVector)
+	{
+		AbleMembers.StableSort([this](const FEnemySquadMember& A, const FEnemySquadMember& B)
+		{
+			return FVector::DistSquared(A.Agent->GetOwner()->GetActorLocation(), TargetLocation) >
+				FVector::DistSquared(B.Agent->GetOwner()->GetActorLocation(), TargetLocation);
+		});
+	}
+
+	for (int32 Index = 0; Index < AbleMembers.Num(); Index++)
+	{
+		AssignRole(*AbleMembers[Index], Roles[FMath::Min(Index, Roles.Num() - 1)]);
+	}
+}
+
+void UEnemySquad::AssignRole(FEnemySquadMember& Member, ESquadRole Role)
+{
+	if (Member.bHasRole && Member.Role == Role) return;
+
+	// Whatever the member did for its last role doesn't count towards the new one
+	ResetRoleBeliefs(*Member.Agent->GetBeliefs());
+
+	Member.bHasRole = true;
+	Member.Role = Role;
+	Member.Agent->SetAssignedGoal(RoleGoals[static_cast<int32>(Role)], MemberPlanDepth);
+	FGOAPTrace::Record(EGOAPTraceEvent::GoalChanged, Member.Agent->GetOwner()->GetFName(),
+		UEnum::GetValueAsName(Role));
+}
+
+void UEnemySquad::ClearRole(FEnemySquadMember& Member)
+{
+	if (!Member.bHasRole) return;
+
+	ResetRoleBeliefs(*Member.Agent->GetBeliefs());
+
+	Member.bHasRole = false;
+	Member.Agent->SetAssignedGoal(nullptr);
+}
+
+void UEnemySquad::Disband()
+{
+	for (FEnemySquadMember& Member : Members)
+	{
+		if (IsValid(Member.Agent) && Member.Agent->GetBeliefs())
+		{
+			ClearRole(Member);
+		}
+	}
+	bHasPlanned = false;
+}
+
+void UEnemySquad::UpdatePositions(bool bTargetSpotted)
+{
+	if (TargetLocation == FVector::ZeroVector) return;
+
+	FVector Centre = FVector::ZeroVector;
+	for (const FEnemySquadMember& Member : Members)
+	{
+		Centre += Member.Agent->GetOwner()->GetActorLocation() / Members.Num();
+	}
+	// The flanking positions are to either side of the line from the squad to the target.
+	FVector Away = (Centre - TargetLocation).GetSafeNormal2D();
+	if (Away.IsZero())
+	{
+		Away = FVector::XAxisVector;
+	}
+	const FVector Side = FVector::CrossProduct(Away, FVector::UpVector);
+
+	int32 NumFlankers = 0;
+	for (FEnemySquadMember& Member : Members)
+	{
+		TMap<FString, FVector>& BeliefVectors = Member.Agent->GetBeliefs()->GetBeliefsStateVectors();
+		// Members that can't see the target still know where the rest of the squad saw it.
+		if (bTargetSpotted)
+		{
+			BeliefVectors.Add("LastKnownTargetPosition", TargetLocation);
+		}
+		if (!Member.bHasRole) continue;
+
+		const FVector MemberLocation = Member.Agent->GetOwner()->GetActorLocation();
+		switch (Member.Role)
+		{
+		case ESquadRole::Suppress:
+			{
+				FVector Direction = (MemberLocation - TargetLocation).GetSafeNormal2D();
+				BeliefVectors.Add("SquadPosition",
+					TargetLocation + (Direction.IsZero() ? Away : Direction) * SuppressDistance);
+			}
+			break;
+		case ESquadRole::Flank:
+			// Every other flanker goes round the other side.
+			BeliefVectors.Add("SquadPosition",
+				TargetLocation + Side * FlankDistance * (NumFlankers++ % 2 == 0 ? 1.0f : -1.0f));
+			break;
+		case ESquadRole::Advance:
+			break;
+		}
+	}
+}
+
+bool UEnemySquad::IsAbleToTakeRole(const FEnemySquadMember& Member)
+{
+	return !Member.Agent->GetBeliefs()->GetBelief(GOAPFacts::InDangerOfDeath);
+}
@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SquadRoleGoal.h"
+#include "GOAP base/Planner.h"
+#include "UObject/NoExportTypes.h"
+#include "EnemySquad.generated.h"
+
+class UEnemyAgent;
+
+/**
+ * A member of a squad and the role it was last given.
+ */
+USTRUCT()
+struct FEnemySquadMember
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UEnemyAgent* Agent = nullptr;
+
+	bool bHasRole = false;
+	ESquadRole Role = ESquadRole::Advance;
+
+	// Whether the member was able to take a role when the roles were last handed out.
+	bool bWasAble = false;
+};
+
+/**
+ * A group of enemies that were spawned together and go after the same target. Instead of every member planning the
+ * whole fight for itself, the squad plans once for all of them: it searches for a plan of squad tactics (suppress,
+ * flank, advance) over what the squad as a whole knows, and hands each step out as a role. Each member is then given
+ * its role's goal as a small local problem, which it plans for with a short search of its own. The squad only plans
+ * again when what it knows changes or a member joins, leaves or drops out to look after itself.
+ *
+ * The steps of the squad's plan are carried out at the same time by different members. The member furthest from the
+ * target takes the first step, and members left over once every step has been handed out take the last one.
+ */
+UCLASS()
+class AGP_API UEnemySquad : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UEnemySquad();
+
+	void AddMember(UEnemyAgent* Agent);
+
+	/**
+	 * Will find out what the squad knows from its members, plan the roles again if that has changed and update where
+	 * each member should be for its role. Called once a frame by the UEnemySquadSubsystem.
+	 * @return False if fewer than two members are left, in which case the squad has disbanded.
+	 */
+	bool Tick();
+
+	/**
+	 * Will take the roles back off every member, so they plan for their own goals again.
+	 */
+	void Disband();
+
+	int32 GetNumMembers() const { return Members.Num(); }
+
+protected:
+	// The most actions a member's plan for its role can have.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	int32 MemberPlanDepth = 3;
+
+	// How far from the target the suppressing members hold back.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	float SuppressDistance = 1500.0f;
+
+	// How far to the side of the target the flanking members go.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	float FlankDistance = 1000.0f;
+
+private:
+	UPROPERTY(VisibleAnywhere, Category="GOAP")
+	TArray<FEnemySquadMember> Members;
+
+	// One goal per role, indexed by the role.
+	UPROPERTY()
+	TArray<USquadRoleGoal*> RoleGoals;
+
+	// The squad's facts the roles were last planned from.
+	FGOAPFactSet PlannedFacts;
+	bool bHasPlanned = false;
+
+	// Where the squad last saw its target. Zero if it never has.
+	FVector TargetLocation = FVector::ZeroVector;
+
+	FGOAPSearchBuffers SearchBuffers;
+
+	/**
+	 * Will search for the squad's plan from its facts.
+	 * @param OutRoles Will be filled with the role for every step of the plan, in order.
+	 * @return True if a plan was found.
+	 */
+	bool PlanRoles(const FGOAPFactSet& Facts, TArray<ESquadRole>& OutRoles);
+
+	/**
+	 * Will hand the roles out to the members that are able to take one.
+	 */
+	void AssignRoles(TConstArrayView<ESquadRole> Roles);
+
+	void AssignRole(FEnemySquadMember& Member, ESquadRole Role);
+	void ClearRole(FEnemySquadMember& Member);
+
+	/**
+	 * Will tell every member where the target is and where it should be for its role.
+	 */
+	void UpdatePositions(bool bTargetSpotted);
+
+	/**
+	 * @return True if the member can take a role, i.e. it isn't busy staying alive.
+	 */
+	static bool IsAbleToTakeRole(const FEnemySquadMember& Member);
+};
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AGP/GoalActionOrientatedPlanning/EnemySquadSubsystem.h"
+
+#include "EnemyAgent.h"
+#include "EnemySquad.h"
+#include "AGP/Characters/EnemyCharacter.h"
+
+UEnemySquad* UEnemySquadSubsystem::CreateSquad(TConstArrayView<AEnemyCharacter*> Enemies)
+{
+	UEnemySquad* Squad = NewObject<UEnemySquad>(this);
+	for (AEnemyCharacter* Enemy : Enemies)
+	{
+		if (IsValid(Enemy))
+		{
+			Squad->AddMember(Enemy->FindComponentByClass<UEnemyAgent>());
+		}
+	}
+	if (Squad->GetNumMembers() < 2) return nullptr;
+
+	Squads.Add(Squad);
+	return Squad;
+}
+
+void UEnemySquadSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	Squads.RemoveAll([](UEnemySquad* Squad) { return !Squad->Tick(); });
+}
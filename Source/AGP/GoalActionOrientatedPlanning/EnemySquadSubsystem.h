@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySquadSubsystem.generated.h"
+
+class AEnemyCharacter;
+class UEnemySquad;
+
+/**
+ * Owns the enemy squads of a world and plans for each of them once a frame, after every actor has ticked. Squads are
+ * dropped once they have fewer than two members left.
+ */
+UCLASS()
+class AGP_API UEnemySquadSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+
+	virtual TStatId GetStatId() const override
+	{
+		return TStatId();
+	}
+
+	/**
+	 * Will group the enemies into a squad, if at least two of them have an enemy agent.
+	 * @param Enemies The enemies to group, normally the ones spawned together.
+	 * @return The new squad, or null if there weren't enough enemies for one.
+	 */
+	UEnemySquad* CreateSquad(TConstArrayView<AEnemyCharacter*> Enemies);
+
+	int32 GetNumSquads() const { return Squads.Num(); }
+
+protected:
+
+	virtual void Tick(float DeltaTime) override;
+
+private:
+
+	UPROPERTY()
+	TArray<UEnemySquad*> Squads;
+};
@@ -1,3 +1,70 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AGP/GoalActionOrientatedPlanning/FlankAction.h"
 
+#include "EnemyAgent.h"
+#include "EnemyAgentBeliefs.h"
+#include "AGP/Characters/EnemyCharacter.h"
+
+namespace
+{
+	constexpr FGOAPActionDescriptor FlankActionDescriptor = FGOAPActionDescriptor(4.0f)
+		.Requires(GOAPFacts::InDangerOfDeath, false)
+		.Causes(GOAPFacts::FlankingTarget, true)
+		.Causes(GOAPFacts::WithinRange, true);
+
+	// How close the member has to get to its flanking position. The paths only go as far as the nearest node.
+	constexpr float ReachedPositionDistance = 300.0f;
+}
+
+UFlankAction::UFlankAction()
+{
+	SetDescriptor(FlankActionDescriptor);
+}
+
+bool UFlankAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	// Only members of a squad are given somewhere to flank to
+	const bool bHasFlankPosition = Beliefs.GetBeliefsStateVectorsConst().FindRef("SquadPosition") != FVector::ZeroVector;
+	const bool bNotInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == false;
+	return bHasFlankPosition && bNotInDangerOfDeath;
+}
+
+float UFlankAction::GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const float Cost = Super::GetCost(WorldState, Beliefs);
+	const UEnemyAgentBeliefs* EnemyBeliefs = Cast<UEnemyAgentBeliefs>(&Beliefs);
+	if (!EnemyBeliefs) return Cost;
+
+	// Going round the target in the open is riskier the further it is
+	return Cost + EnemyBeliefs->GetDistanceToSquadPosition() / 1000.0f;
+}
+
+void UFlankAction::PerformAction(FGOAPActionContext& Context) const
+{
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
+	FVector FlankPosition = EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("SquadPosition");
+	EnemyCharacter->TickGoToLocation(FlankPosition);
+}
+
+bool UFlankAction::IsActionComplete(const FGOAPActionContext& Context) const
+{
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
+	const FVector FlankPosition = EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("SquadPosition");
+	const bool bReachedFlankPosition =
+		FVector::Dist(FlankPosition, EnemyCharacter->GetActorLocation()) <= ReachedPositionDistance;
+	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::InDangerOfDeath);
+	return bReachedFlankPosition || bInDangerOfDeath || FlankPosition == FVector::ZeroVector;
+}
+
+void UFlankAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
+{
+	// Flanking is this member's own fact rather than the team's, so it is kept in its beliefs. It is only true if the
+	// member actually got there.
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	const FVector FlankPosition = EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("SquadPosition");
+	const bool bReachedFlankPosition =
+		FVector::Dist(FlankPosition, Context.Character->GetActorLocation()) <= ReachedPositionDistance;
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::FlankingTarget, bReachedFlankPosition);
+}
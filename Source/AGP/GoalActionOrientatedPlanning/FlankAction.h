@@ -7,11 +7,18 @@
 #include "FlankAction.generated.h"
 
 /**
- * 
+ * Moves round to the side of the target, to the position the member's squad picked for it (the SquadPosition
+ * belief), so that it can attack from there while another member keeps the target pinned down.
  */
 UCLASS()
 class AGP_API UFlankAction : public UAction
 {
 	GENERATED_BODY()
+	UFlankAction();
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual float GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 	
 };
@@ -3,7 +3,7 @@
 
 #include "Action.h"
 
-TMap<FString, bool> UAction::GetPreconditions()
+const FGOAPFactSet& UAction::GetPreconditions() const
 {
 	return Preconditions;
 }
@@ -13,7 +13,7 @@ TMap<FString, FVector> UAction::GetPreconditionsVectors()
 	return PreconditionsVectors;
 }
 
-TMap<FString, bool> UAction::GetEffects()
+const FGOAPFactSet& UAction::GetEffects() const
 {
 	return Effects;
 }
@@ -23,37 +23,40 @@ TMap<FString, FVector> UAction::GetEffectsVectors()
 	return EffectVectors;
 }
 
+void UAction::SetDescriptor(const FGOAPActionDescriptor& Descriptor)
+{
+	Preconditions = Descriptor.Preconditions;
+	Effects = Descriptor.Effects;
+	cost = Descriptor.Cost;
+}
+
 float UAction::Getcost()
 {
 	return cost;
 }
 
-bool UAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+float UAction::GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	return cost;
+}
+
+bool UAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
     return true;
 }
 
-void UAction::ApplyEffects(UWorldState& WorldState)
+void UAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	TMap<FString, bool> NewWorldState = WorldState.GetWorldState();
-	TMap<FString, FVector> NewWorldStateVectors = WorldState.GetWorldVectorState();
-	for(const TPair<FString, bool>& Effect : Effects )
-	{
-		NewWorldState.Add(Effect.Key, Effect.Value);
-	}
-	for(const TPair<FString, FVector>& Effect : EffectVectors )
-	{
-		NewWorldStateVectors.Add(Effect.Key, Effect.Value);
-	}
-	WorldState.UpdateState(NewWorldState);
-	WorldState.UpdateVectorState(NewWorldStateVectors);
+	WorldState.UpdateState(Effects);
+	WorldState.UpdateState(Context.ExtraEffects);
+	WorldState.UpdateVectorState(EffectVectors);
 }
 
-bool UAction::IsActionComplete() const
+bool UAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
 	return true;
 }
 
-void UAction::PerformAction()
+void UAction::PerformAction(FGOAPActionContext& Context) const
 {
 }
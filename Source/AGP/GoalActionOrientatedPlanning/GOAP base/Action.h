@@ -8,9 +8,84 @@
 #include "UObject/NoExportTypes.h"
 #include "Action.generated.h"
 
+class ACharacter;
+class UAction;
+class UAgent;
 
 /**
- * 
+ * The facts an action reads and writes and what it costs, declared as a constant expression in the action's source
+ * file. Every instance of the action copies it in its constructor, so a new action only has to declare one of these:
+ *
+ * constexpr FGOAPActionDescriptor HideActionDescriptor = FGOAPActionDescriptor(1.0f)
+ *     .Requires(GOAPFacts::ThiefVisible, true)
+ *     .Causes(GOAPFacts::ThiefVisible, false);
+ */
+struct FGOAPActionDescriptor
+{
+	FGOAPFactSet Preconditions;
+	FGOAPFactSet Effects;
+	float Cost = 0.0f;
+
+	constexpr explicit FGOAPActionDescriptor(float InCost) : Cost(InCost) {}
+
+	/**
+	 * @return A copy of this descriptor that also needs the fact to have the value before the action can run.
+	 */
+	constexpr FGOAPActionDescriptor Requires(FGOAPFactId FactId, bool bValue) const
+	{
+		FGOAPActionDescriptor Descriptor = *this;
+		Descriptor.Preconditions.Set(FactId, bValue);
+		return Descriptor;
+	}
+
+	/**
+	 * @return A copy of this descriptor that also sets the fact to the value once the action is done.
+	 */
+	constexpr FGOAPActionDescriptor Causes(FGOAPFactId FactId, bool bValue) const
+	{
+		FGOAPActionDescriptor Descriptor = *this;
+		Descriptor.Effects.Set(FactId, bValue);
+		return Descriptor;
+	}
+};
+
+/**
+ * What one agent keeps while it executes an action. Actions are shared by every agent that uses them, so anything an
+ * action needs to remember from one tick to the next is kept here instead of on the action. The agent starts a fresh
+ * context every time it starts an action.
+ */
+USTRUCT()
+struct FGOAPActionContext
+{
+	GENERATED_BODY()
+
+	// The action this context is for.
+	UPROPERTY()
+	UAction* Action = nullptr;
+
+	// The agent executing the action and the character it controls.
+	UPROPERTY()
+	UAgent* Agent = nullptr;
+	UPROPERTY()
+	ACharacter* Character = nullptr;
+
+	FTimerHandle TimerHandle;
+
+	// A location the action has picked to go to, if it needs one.
+	FVector TargetLocation = FVector::ZeroVector;
+
+	// For actions that run in stages, e.g. whether the agent has reached the first location yet.
+	bool bStarted = false;
+	bool bDone = false;
+
+	// Facts the action found out about while it ran, which are written along with its effects when it completes.
+	FGOAPFactSet ExtraEffects;
+};
+
+/**
+ * An action's definition: its preconditions, effects and cost, and how it is executed. Actions hold no state for the
+ * agent executing them, so one instance (the class default object) is shared by every agent and can be read from any
+ * number of planners at once. Everything that is specific to one execution is in the FGOAPActionContext passed in.
  */
 UCLASS()
 class AGP_API UAction : public UObject
@@ -19,30 +94,49 @@ class AGP_API UAction : public UObject
 
 protected:
 	//variables
-	UPROPERTY(EditAnywhere, Category="GOAP")
-	TMap<FString,bool> Preconditions;
+	// The facts that have to hold for the action to run. Only the known facts are tested.
+	FGOAPFactSet Preconditions;
 	TMap<FString,FVector> PreconditionsVectors;
 
-	UPROPERTY(EditAnywhere, Category="GOAP")
-	TMap<FString,bool> Effects;
+	// The facts the action changes. Only the known facts are written.
+	FGOAPFactSet Effects;
 	TMap<FString,FVector> EffectVectors;
 
 	UPROPERTY(EditAnywhere, Category="GOAP")
 	float cost;
 
-	UPROPERTY()
-	ACharacter* Character;  
+	/**
+	 * Will set the action's preconditions, effects and cost from its descriptor. Called from the constructor.
+	 */
+	void SetDescriptor(const FGOAPActionDescriptor& Descriptor);
 	
 public:
-	FTimerHandle TimerHandle;
 	//functions
-	TMap<FString,bool> GetPreconditions();
+	const FGOAPFactSet& GetPreconditions() const;
 	TMap<FString,FVector> GetPreconditionsVectors();
-	TMap<FString,bool> GetEffects();
+	const FGOAPFactSet& GetEffects() const;
 	TMap<FString,FVector> GetEffectsVectors();
 	float Getcost();
-	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs);
-	virtual void ApplyEffects (UWorldState& WorldState);
-	virtual bool IsActionComplete() const;
-	virtual void PerformAction();
+
+	/**
+	 * The cost of the action for one agent right now, e.g. a longer walk costing more. It is read every time the agent
+	 * plans, for every action, so it should only read values the beliefs have already worked out rather than querying
+	 * the world.
+	 * @return The fixed cost unless the action overrides this.
+	 */
+	virtual float GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const;
+
+	/**
+	 * Context checks that can't be expressed as facts. This is called for every agent that uses the action, so it can
+	 * only read what it is given.
+	 * @return True if the action can run in the world and for the beliefs given.
+	 */
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const;
+
+	/**
+	 * Will write the action's effects, and any extra effects it found out about, to the world state.
+	 */
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const;
+	virtual void PerformAction(FGOAPActionContext& Context) const;
 };
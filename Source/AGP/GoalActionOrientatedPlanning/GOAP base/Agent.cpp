@@ -8,7 +8,43 @@
 #include "AIController.h"
 #include "Goal.h"      
 #include "WorldState.h" 
+#include "GOAPBlackboardSubsystem.h"
 #include "Beliefs.h"    
+#include "GOAPPlanningSubsystem.h"
+#include "GOAPTrace.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+
+namespace
+{
+	// Totals across every agent, reported by the GOAP.ReplanStats console command.
+	int64 TotalPlansMade = 0;
+	int64 TotalPlansSkipped = 0;
+
+	void LogReplanStats()
+	{
+		static int64 LastPlansMade = 0;
+		static int64 LastPlansSkipped = 0;
+		static double LastTime = FPlatformTime::Seconds();
+
+		const double Now = FPlatformTime::Seconds();
+		const double Elapsed = FMath::Max(Now - LastTime, UE_DOUBLE_SMALL_NUMBER);
+		UE_LOG(LogTemp, Display, TEXT("GOAP plans made: %lld (%.1f per second), replans skipped: %lld (%.1f per second)"),
+			TotalPlansMade, (TotalPlansMade - LastPlansMade) / Elapsed, TotalPlansSkipped,
+			(TotalPlansSkipped - LastPlansSkipped) / Elapsed)
+
+		LastPlansMade = TotalPlansMade;
+		LastPlansSkipped = TotalPlansSkipped;
+		LastTime = Now;
+	}
+
+	FAutoConsoleCommand ReplanStatsCommand(
+		TEXT("GOAP.ReplanStats"),
+		TEXT("Logs how many plans the GOAP agents have made and how many replans were skipped because no relevant fact ")
+		TEXT("changed, in total and per second since the last time this command was run."),
+		FConsoleCommandDelegate::CreateStatic(&LogReplanStats));
+}
 
 
 
@@ -26,7 +62,7 @@ UAgent::UAgent()
 void UAgent::BeginPlay()
 {
 	Super::BeginPlay();
-	WorldState = UWorldState::GetInstance(); 
+	WorldState = GetWorld()->GetSubsystem<UGOAPBlackboardSubsystem>()->GetBlackboard(BlackboardTeam);
 	// Initialize Planner
 	if (!Planner)
 	{
@@ -35,6 +71,22 @@ void UAgent::BeginPlay()
 
 	// Safely get AIController
 	AIController = Cast<AAIController>(GetOwner()->GetInstigatorController());
+
+	// Let the world's planning subsystem schedule planning, whatever the game mode is.
+	if (UGOAPPlanningSubsystem* PlanningSubsystem = GetWorld()->GetSubsystem<UGOAPPlanningSubsystem>())
+	{
+		PlanningSubsystem->RegisterAgent(this);
+	}
+}
+
+void UAgent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Scheduler)
+	{
+		Scheduler->UnregisterAgent(this);
+	}
+	StartActionContext(nullptr);
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -44,13 +96,31 @@ void UAgent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponent
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	if(GoalAchieved())
 	{
-		PlanActions();
+		PlanActionsIfDirty();
 	}
 	else
 	{
 		//UE_LOG(LogTemp, Log, TEXT("Performing..."));
 		PerformAction();
+
+		// A partial plan is followed while a better one is searched for.
+		if (bRefiningPlan)
+		{
+			PlanActionsIfDirty();
+		}
 	}
+
+#if GOAP_TRACE_ENABLED
+	if (Beliefs)
+	{
+		const FName TraceName = GetTraceName();
+		if (FGOAPTrace::IsTracing(TraceName))
+		{
+			FGOAPTrace::RecordFactChanges(TraceName, TracedBeliefFacts, Beliefs->GetBeliefsStateConst());
+			TracedBeliefFacts = Beliefs->GetBeliefsStateConst();
+		}
+	}
+#endif
 	// ...
  
 
@@ -58,10 +128,201 @@ void UAgent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponent
 
 bool UAgent::PlanActions()
 { 
-	CurrentPlan = Planner->FindBestPlan(this, *WorldState, GetBeliefsConst()); 
+	CommitPlan(UPlanner::ChooseBestPlan(CapturePlanSnapshot(), *Planner->GetSearchBuffers()));
+	return CurrentPlan.Num() > 0;
+}
+
+FGOAPPlanSnapshot UAgent::CapturePlanSnapshot(int32 MaxSearchNodes)
+{
+	RecordPlannedFacts();
+	bPlanPending = false;
+	bPlanInFlight = true;
+	SnapshotAssignedGoalVersion = AssignedGoalVersion;
+	FGOAPPlanSnapshot Snapshot = Planner->MakeSnapshot(this, *WorldState, GetBeliefsConst());
+	if (bRefiningPlan)
+	{
+		const int64 RefinedSearchNodes = int64(Snapshot.MaxSearchNodes) << FMath::Min(NumPlanRefinements, 16);
+		Snapshot.MaxSearchNodes =
+			static_cast<int32>(FMath::Min<int64>(RefinedSearchNodes, Planner->GetMaxRefinedSearchNodes()));
+	}
+	if (MaxSearchNodes > 0)
+	{
+		Snapshot.MaxSearchNodes = FMath::Min(Snapshot.MaxSearchNodes, MaxSearchNodes);
+	}
+	LastSearchNodeLimit = Snapshot.MaxSearchNodes;
+	return Snapshot;
+}
+
+void UAgent::CommitPlan(const FGOAPPlanResult& Result)
+{
+	const FName TraceName = GetTraceName();
+	if (FGOAPTrace::IsTracing(TraceName))
+	{
+		if (Result.Goal && Result.Goal != CurrentGoal)
+		{
+			FGOAPTrace::Record(EGOAPTraceEvent::GoalChanged, TraceName, Result.Goal->GetClass()->GetFName());
+		}
+		const UGoal* PlannedGoal = Result.Goal ? Result.Goal : CurrentGoal;
+		FGOAPTrace::Record(EGOAPTraceEvent::PlanCommitted, TraceName,
+			PlannedGoal ? PlannedGoal->GetClass()->GetFName() : NAME_None, Result.Plan.Num());
+		for (int32 Index = 0; Index < Result.Plan.Num(); Index++)
+		{
+			FGOAPTrace::Record(EGOAPTraceEvent::PlanStep, TraceName, Result.Plan[Index]->GetClass()->GetFName(), Index);
+		}
+	}
+
+	CurrentPlan = Result.Plan;
+	if (Result.Goal)
+	{
+		CurrentGoal = Result.Goal;
+	}
+	// If the assigned goal changed while the plan was being made, the plan is followed until one for the new goal
+	// has been made.
+	bReplanRequested = AssignedGoalVersion != SnapshotAssignedGoalVersion;
+	bPlanInFlight = false;
+	LastPlanTime = FPlatformTime::Seconds();
+
+	// Once a search with the most nodes allowed still can't reach the goal, the partial plan is kept until something
+	// changes, like any other plan.
+	bRefiningPlan = Result.bIsPartial && LastSearchNodeLimit < Planner->GetMaxRefinedSearchNodes();
+	NumPlanRefinements = bRefiningPlan ? NumPlanRefinements + 1 : 0;
+	NumPlansMade++;
+	TotalPlansMade++;
+}
+
+bool UAgent::PlanActionsIfDirty()
+{
+	// The facts are checked again against the snapshot once the plan being made has been committed.
+	if (bPlanInFlight) return CurrentPlan.Num() > 0;
+
+	if (ShouldReplan())
+	{
+		if (!Scheduler)
+		{
+			return PlanActions();
+		}
+		bPlanPending = true;
+		return CurrentPlan.Num() > 0;
+	}
+	NumPlansSkipped++;
+	TotalPlansSkipped++;
 	return CurrentPlan.Num() > 0;
 }
 
+bool UAgent::ShouldReplan() const
+{
+	if (bReplanRequested || bRefiningPlan || !WorldState || !Beliefs) return true;
+
+	FGOAPFactSet ChangedFacts = WorldState->GetWorldState().GetChangedFacts(PlannedWorldFacts);
+	ChangedFacts.AddKnownFacts(Beliefs->GetBeliefsStateConst().GetChangedFacts(PlannedBeliefFacts));
+	if (ChangedFacts.IsEmpty()) return false;
+
+	// With no plan to follow any change might make a goal reachable.
+	if (CurrentPlan.Num() == 0) return true;
+
+	FGOAPFactSet WatchedFacts;
+	for (const UAction* Action : CurrentPlan)
+	{
+		WatchedFacts.AddKnownFacts(Action->GetPreconditions());
+	}
+	for (const UGoal* Goal : Goals)
+	{
+		if (Goal->GetRelevanceFacts().IsEmpty()) return true;
+		WatchedFacts.AddKnownFacts(Goal->GetRelevanceFacts());
+		WatchedFacts.AddKnownFacts(Goal->GetUtilityFacts());
+	}
+	if (AssignedGoal)
+	{
+		if (AssignedGoal->GetRelevanceFacts().IsEmpty()) return true;
+		WatchedFacts.AddKnownFacts(AssignedGoal->GetRelevanceFacts());
+	}
+	return ChangedFacts.SharesKnownFacts(WatchedFacts);
+}
+
+void UAgent::SetScheduler(UGOAPPlanningSubsystem* NewScheduler)
+{
+	Scheduler = NewScheduler;
+	bPlanPending = false;
+}
+
+bool UAgent::IsPlanPending() const
+{
+	return bPlanPending;
+}
+
+bool UAgent::IsPlanInFlight() const
+{
+	return bPlanInFlight;
+}
+
+UPlanner* UAgent::GetPlanner() const
+{
+	return Planner;
+}
+
+double UAgent::GetLastPlanTime() const
+{
+	return LastPlanTime;
+}
+
+bool UAgent::NeedsNewPlan() const
+{
+	return bReplanRequested || CurrentPlan.Num() == 0;
+}
+
+void UAgent::SetAssignedGoal(UGoal* Goal, int32 MaxPlanDepth)
+{
+	AssignedPlanDepth = MaxPlanDepth;
+	if (Goal == AssignedGoal) return;
+
+	AssignedGoal = Goal;
+	AssignedGoalVersion++;
+	// The plan being followed was made for a different problem.
+	bReplanRequested = true;
+	NumPlanRefinements = 0;
+}
+
+UGoal* UAgent::GetAssignedGoal() const
+{
+	return AssignedGoal;
+}
+
+int32 UAgent::GetAssignedPlanDepth() const
+{
+	return AssignedPlanDepth;
+}
+
+float UAgent::GetGoalUtility(const UGoal* Goal, const FGOAPFactSet& Facts)
+{
+	const FGOAPFactSet Inputs = Facts.GetMasked(Goal->GetUtilityFacts());
+	if (const FGOAPCachedUtility* CachedUtility = GoalUtilities.Find(Goal))
+	{
+		if (CachedUtility->Inputs == Inputs)
+		{
+			NumUtilitiesCached++;
+			return CachedUtility->Utility;
+		}
+	}
+
+	NumUtilitiesCalculated++;
+	FGOAPCachedUtility& CachedUtility = GoalUtilities.Add(Goal);
+	CachedUtility.Inputs = Inputs;
+	CachedUtility.Utility = Goal->CalculateUtility(Inputs);
+	return CachedUtility.Utility;
+}
+
+void UAgent::RecordPlannedFacts()
+{
+	if (WorldState)
+	{
+		PlannedWorldFacts = WorldState->GetWorldState();
+	}
+	if (Beliefs)
+	{
+		PlannedBeliefFacts = Beliefs->GetBeliefsStateConst();
+	}
+}
+
 void UAgent::PerformAction()
 {
 	if (CurrentPlan.Num() == 0)
@@ -71,25 +332,71 @@ void UAgent::PerformAction()
 	}
 	//UE_LOG(LogTemp, Log, TEXT("Current Plan filled up boss"));
 	UAction* CurrentAction = CurrentPlan[0];  
-	if (CurrentAction->IsActionComplete())
+	if (ActionContext.Action != CurrentAction)
+	{
+		StartActionContext(CurrentAction);
+	}
+	if (CurrentAction->IsActionComplete(ActionContext))
 	{
-		CurrentAction->ApplyEffects(*WorldState);
+		CurrentAction->ApplyEffects(ActionContext, *WorldState);
+		// The same action can come up again straight away, and it has to start over when it does.
+		StartActionContext(nullptr, true);
 		CurrentPlan.RemoveAt(0);  
+		if (CurrentPlan.Num() == 0)
+		{
+			bReplanRequested = true;
+		}
+		else if (!bPlanInFlight)
+		{
+			// The plan expected the action's effects, so they don't make it out of date. The world only shows them
+			// once the blackboard is published, so they are applied to the planned facts rather than read back.
+			PlannedWorldFacts.Apply(CurrentAction->GetEffects());
+			if (Beliefs)
+			{
+				PlannedBeliefFacts = Beliefs->GetBeliefsStateConst();
+			}
+		}
 	}
 	else
 	{
-		CurrentAction->PerformAction();  
+		CurrentAction->PerformAction(ActionContext);  
 	}
 }
 
+void UAgent::StartActionContext(UAction* Action, bool bLastActionCompleted)
+{
+	if (ActionContext.Action)
+	{
+		FGOAPTrace::Record(EGOAPTraceEvent::ActionFinished, GetTraceName(), ActionContext.Action->GetClass()->GetFName(),
+			bLastActionCompleted);
+	}
+	if (ActionContext.TimerHandle.IsValid() && GetWorld())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(ActionContext.TimerHandle);
+	}
+	ActionContext = FGOAPActionContext();
+	ActionContext.Action = Action;
+	ActionContext.Agent = this;
+	ActionContext.Character = Cast<ACharacter>(GetOwner());
+	if (Action)
+	{
+		FGOAPTrace::Record(EGOAPTraceEvent::ActionStarted, GetTraceName(), Action->GetClass()->GetFName());
+	}
+}
+
+FName UAgent::GetTraceName() const
+{
+	return GetOwner() ? GetOwner()->GetFName() : GetFName();
+}
+
 bool UAgent::GoalAchieved()
 {
 	return CurrentPlan.Num() == 0;
 }
 
-void UAgent::UpdateBelief(const FString& Key, bool Value)
+void UAgent::UpdateBelief(FGOAPFactId FactId, bool Value)
 {
-	Beliefs->GetBeliefsState().Add(Key, Value);
+	Beliefs->SetBelief(FactId, Value);
 }
 
 void UAgent::UpdateBelief(const FString& Key, FVector Value)
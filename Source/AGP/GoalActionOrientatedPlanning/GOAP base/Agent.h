@@ -4,7 +4,10 @@
 
 #include "CoreMinimal.h" 
 #include "Components/ActorComponent.h"
+#include "Action.h"
+#include "GOAPFacts.h"
 #include "Perception/AIPerceptionStimuliSourceComponent.h"
+#include "UObject/ObjectKey.h"
 #include "Agent.generated.h"
 
 
@@ -17,6 +20,18 @@ class UAction;
 class UWorldState;
 class UBeliefs;
 class UPlanner;
+class UGOAPPlanningSubsystem;
+struct FGOAPPlanSnapshot;
+struct FGOAPPlanResult;
+
+/**
+ * A goal's utility for an agent and the utility facts it was calculated from.
+ */
+struct FGOAPCachedUtility
+{
+	FGOAPFactSet Inputs;
+	float Utility = 0.0f;
+};
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class AGP_API UAgent : public UActorComponent
@@ -30,20 +45,30 @@ public:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	//variables
 	UPROPERTY(VisibleAnywhere, Category = "GOAP")
 	TArray<UGoal*> Goals;
 	
+	// The actions are shared by every agent that uses them, normally as their class default objects.
 	UPROPERTY(EditAnywhere, Category = "GOAP")
 	TArray<UAction*> AvailableAction;
 
 	UPROPERTY(VisibleAnywhere, Category = "GOAP")
 	TArray<UAction*> CurrentPlan;
 
+	// This agent's state for the action it is executing, the first action of the plan.
+	UPROPERTY()
+	FGOAPActionContext ActionContext;
+
 	UPROPERTY(VisibleAnywhere, Category = "GOAP")
 	UWorldState* WorldState;
 
+	// Agents on the same team share a blackboard. Agents that leave this empty share the default one.
+	UPROPERTY(EditAnywhere, Category = "GOAP")
+	FName BlackboardTeam;
+
 	UPROPERTY(VisibleAnywhere, Category = "GOAP")
 	UBeliefs* Beliefs;
 
@@ -72,6 +97,86 @@ protected:
 	UPROPERTY()
 	UAIPerceptionStimuliSourceComponent* StimuliSourceComponent;
 
+	// The world facts and beliefs as they were when the current plan was made, to find out which facts have changed since.
+	FGOAPFactSet PlannedWorldFacts;
+	FGOAPFactSet PlannedBeliefFacts;
+
+	// Set when the plan has run out, so the next call to PlanActionsIfDirty always replans.
+	bool bReplanRequested = true;
+
+	// The world's planning subsystem, which decides when this agent gets to plan.
+	UPROPERTY()
+	UGOAPPlanningSubsystem* Scheduler = nullptr;
+
+	// Set while this agent is waiting for the scheduler to plan for it.
+	bool bPlanPending = false;
+
+	// Set between taking a snapshot and committing the plan made from it.
+	bool bPlanInFlight = false;
+
+	// When this agent last planned, used by the scheduler to share planning out evenly.
+	double LastPlanTime = 0.0;
+
+	// Set while the agent follows a partial plan and keeps searching for one that reaches the goal. Every partial plan
+	// in a row doubles the node limit of the next search, until it reaches the planner's MaxRefinedSearchNodes.
+	bool bRefiningPlan = false;
+	int32 NumPlanRefinements = 0;
+
+	// The node limit of the search made from the last snapshot.
+	int32 LastSearchNodeLimit = 0;
+
+	// A goal handed to the agent by whatever coordinates it, such as its squad. See SetAssignedGoal.
+	UPROPERTY(VisibleAnywhere, Category = "GOAP")
+	UGoal* AssignedGoal = nullptr;
+
+	// If more than 0, plans for the assigned goal are at most this many actions long.
+	int32 AssignedPlanDepth = 0;
+
+	// Counts the changes to the assigned goal, and what the count was when the last snapshot was taken. A plan
+	// committed with a different count was made for the old goal, so the agent plans again straight away.
+	int32 AssignedGoalVersion = 0;
+	int32 SnapshotAssignedGoalVersion = 0;
+
+	// The utility of every goal this agent has planned for, so it is only calculated again when its facts change.
+	TMap<TObjectKey<UGoal>, FGOAPCachedUtility> GoalUtilities;
+
+	// How many times a goal's utility had to be calculated and how many times the cached one could be used.
+	UPROPERTY(VisibleAnywhere, Category = "GOAP")
+	int32 NumUtilitiesCalculated = 0;
+	UPROPERTY(VisibleAnywhere, Category = "GOAP")
+	int32 NumUtilitiesCached = 0;
+
+	// How many times this agent has planned and how many times a replan was skipped because nothing relevant changed.
+	UPROPERTY(VisibleAnywhere, Category = "GOAP")
+	int32 NumPlansMade = 0;
+	UPROPERTY(VisibleAnywhere, Category = "GOAP")
+	int32 NumPlansSkipped = 0;
+
+	/**
+	 * @return True if the plan has run out, or a fact that the remaining plan or a goal's relevance test depends on has
+	 * changed since the plan was made.
+	 */
+	bool ShouldReplan() const;
+
+	/**
+	 * Will remember the current facts as the ones the plan was made from.
+	 */
+	void RecordPlannedFacts();
+
+	/**
+	 * Will give the action a fresh context, clearing any timer the last action left running.
+	 * @param bLastActionCompleted Whether the action the old context was for completed, or was cut short.
+	 */
+	void StartActionContext(UAction* Action, bool bLastActionCompleted = false);
+
+	// The beliefs as they were last traced, to find out which of them have flipped since.
+	FGOAPFactSet TracedBeliefFacts;
+
+	/**
+	 * @return The name this agent's decisions are traced under, the name of the actor that owns it.
+	 */
+	FName GetTraceName() const;
+
 	
 public:	
 	// Called every frame
@@ -80,9 +185,59 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	
 	virtual bool PlanActions();
+
+	/**
+	 * Will only replan if ShouldReplan says the current plan might be out of date. Sensors should call this instead of
+	 * PlanActions so that agents don't replan every time they look around. If the agent has a scheduler this only asks
+	 * it for a plan, and the agent carries on with its current plan until the scheduler gets to it.
+	 * @return True if the agent has a plan.
+	 */
+	bool PlanActionsIfDirty();
+
+	/**
+	 * Will take the snapshot that the next plan is made from and remember the facts it was taken from. Has to be called
+	 * on the game thread.
+	 * @param MaxSearchNodes If more than 0 the search is limited to this many nodes, so it returns a partial plan
+	 * quickly if it can't finish.
+	 */
+	FGOAPPlanSnapshot CapturePlanSnapshot(int32 MaxSearchNodes = 0);
+
+	/**
+	 * Will take over a plan made from the last snapshot. The agent keeps executing its old plan until this is called.
+	 */
+	void CommitPlan(const FGOAPPlanResult& Result);
+
+	void SetScheduler(UGOAPPlanningSubsystem* NewScheduler);
+	bool IsPlanPending() const;
+	bool IsPlanInFlight() const;
+	UPlanner* GetPlanner() const;
+	double GetLastPlanTime() const;
+
+	/**
+	 * @return True if the agent has no plan left to follow, as opposed to a plan that might just be out of date.
+	 */
+	bool NeedsNewPlan() const;
+
+	/**
+	 * Will narrow the agent's planning down to a small local problem. While the assigned goal is relevant it is the
+	 * only goal planned for, apart from the agent's own goals with a higher priority, and the plans for it are kept
+	 * short. The agent replans straight away if the goal changes.
+	 * @param Goal The goal to plan for, or null to go back to planning for the agent's own goals.
+	 * @param MaxPlanDepth If more than 0, the most actions a plan for the goal can have.
+	 */
+	void SetAssignedGoal(UGoal* Goal, int32 MaxPlanDepth = 0);
+	UGoal* GetAssignedGoal() const;
+	int32 GetAssignedPlanDepth() const;
+
+	/**
+	 * @param Facts The facts the agent plans from, the world's facts with its beliefs on top.
+	 * @return The goal's utility for this agent. It is only calculated again if one of the goal's utility facts has
+	 * changed since the last time.
+	 */
+	float GetGoalUtility(const UGoal* Goal, const FGOAPFactSet& Facts);
 	virtual void PerformAction();
 	bool GoalAchieved();
-	void UpdateBelief(const FString& Key, bool Value);
+	void UpdateBelief(FGOAPFactId FactId, bool Value);
 	void UpdateBelief(const FString& Key, FVector Value);
 	void DebugDrawSightPerception();
 	UGoal* GetCurrentGoal();
@@ -6,6 +6,7 @@
 #include "Perception/AISense_Sight.h"
 #include "Perception/AISenseConfig_Sight.h" 
 #include "Agent.h"
+#include "GOAPBlackboardSubsystem.h"
 
 class UAgent;
 class UAIPerceptionComponent;
@@ -63,7 +64,8 @@ void UAgentSensor::UpdateBeliefsFromSensors()
 void UAgentSensor::BeginPlay()
 {
 	Super::BeginPlay();
-	WorldState = UWorldState::GetInstance(); 
+	WorldState = OwnerAgent ? OwnerAgent->GetWorldState()
+		: GetWorld()->GetSubsystem<UGOAPBlackboardSubsystem>()->GetBlackboard(NAME_None);
 
 	// ...
 	
@@ -89,10 +91,10 @@ UAgent* UAgentSensor::GetTheOwner()
 	return OwnerAgent;
 }
 
-void UAgentSensor::UpdateBelief(const FString& Key, bool Value)
+void UAgentSensor::UpdateBelief(FGOAPFactId FactId, bool Value)
 {
 	if(OwnerAgent)
-		OwnerAgent->UpdateBelief(Key, Value);
+		OwnerAgent->UpdateBelief(FactId, Value);
 }
 
 void UAgentSensor::UpdateBelief(const FString& Key, FVector Value)
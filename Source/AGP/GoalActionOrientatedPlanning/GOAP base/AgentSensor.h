@@ -53,15 +53,14 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// Belief system (you can replace this with your actual belief structure)
-	UPROPERTY()
-	TMap<FString, bool> Beliefs;
+	FGOAPFactSet Beliefs;
 	void SetOwnerAgent(UAgent* Agent);
 	virtual UAgent* GetTheOwner();
 
 	// Array to store detected actors
 	UPROPERTY()
 	TArray<AActor*> DetectedActors;
-	void UpdateBelief(const FString& Key, bool Value);
+	void UpdateBelief(FGOAPFactId FactId, bool Value);
 	void UpdateBelief(const FString& Key, FVector Value);
 	
 
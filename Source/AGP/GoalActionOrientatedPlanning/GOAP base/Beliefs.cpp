@@ -3,12 +3,12 @@
 
 #include "Beliefs.h"
 
-TMap<FString, bool>& UBeliefs::GetBeliefsState()
+FGOAPFactSet& UBeliefs::GetBeliefsState()
 {
 	return BeliefsState;
 }
 
-const TMap<FString, bool>& UBeliefs::GetBeliefsStateConst() const
+const FGOAPFactSet& UBeliefs::GetBeliefsStateConst() const
 {
 	return BeliefsState;
 }
@@ -23,12 +23,24 @@ const TMap<FString, FVector>& UBeliefs::GetBeliefsStateVectorsConst() const
 	return BeliefsStateVectors;
 }
 
-void UBeliefs::UpdateBeliefsState(TMap<FString, bool> NewBeliefs)
+bool UBeliefs::GetBelief(FGOAPFactId FactId) const
 {
-	for (const TPair<FString, bool>& NewBelief : NewBeliefs)
-	{
-		BeliefsState.Add(NewBelief.Key, NewBelief.Value);
-	}
+	return BeliefsState.Get(FactId);
+}
+
+bool UBeliefs::HasBelief(FGOAPFactId FactId) const
+{
+	return BeliefsState.IsKnown(FactId);
+}
+
+void UBeliefs::SetBelief(FGOAPFactId FactId, bool Value)
+{
+	BeliefsState.Set(FactId, Value);
+}
+
+void UBeliefs::UpdateBeliefsState(const FGOAPFactSet& NewBeliefs)
+{
+	BeliefsState.Apply(NewBeliefs);
 }
 
 void UBeliefs::UpdateBeliefsStateVectors(TMap<FString, FVector> NewBeliefs)
@@ -39,11 +51,6 @@ void UBeliefs::UpdateBeliefsStateVectors(TMap<FString, FVector> NewBeliefs)
 	}
 }
 
-void UBeliefs::UpdateBeliefsState(const TPair<FString, bool>& NewBeliefs)
-{
-	BeliefsState.Add(NewBeliefs.Key, NewBeliefs.Value);
-}
-
 void UBeliefs::UpdateBeliefsStateVectors(const TPair<FString, FVector>& NewBeliefs)
 {
 	BeliefsStateVectors.Add(NewBeliefs.Key, NewBeliefs.Value);
@@ -51,15 +58,11 @@ void UBeliefs::UpdateBeliefsStateVectors(const TPair<FString, FVector>& NewBelie
 
 bool UBeliefs::BeliefsMatchesWorldState( const UWorldState& WorldState)const 
 {
-	TMap<FString,bool> ActualWorldState = WorldState.GetWorldState();
-	TMap<FString,FVector> ActualWorldStateVectors = WorldState.GetWorldVectorState();
-	
-	for (const TPair<FString, bool>& Belief  : BeliefsState)
-	{
-		if(ActualWorldState.Contains(Belief.Key))
-			if(Belief.Value != ActualWorldState[Belief.Key])
-				return false;
-	}
+	// Only the facts that both the beliefs and the world know about are compared.
+	if (!BeliefsState.Agrees(WorldState.GetWorldState()))
+		return false;
+
+	const TMap<FString,FVector>& ActualWorldStateVectors = WorldState.VectorStates;
 
 	for (const TPair<FString, FVector>& Belief  : BeliefsStateVectors)
 	{
@@ -71,11 +74,3 @@ bool UBeliefs::BeliefsMatchesWorldState( const UWorldState& WorldState)const
 	return true;
 }
 
-UBeliefs* UBeliefs::Clone()
-{
-	UBeliefs* Clone = NewObject<UBeliefs>();
-	Clone->BeliefsState = this->BeliefsState;  
-	Clone->BeliefsStateVectors = this->BeliefsStateVectors;  
-	return Clone;
-}
-
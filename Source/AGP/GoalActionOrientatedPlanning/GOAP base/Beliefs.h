@@ -16,21 +16,26 @@ class AGP_API UBeliefs : public UObject
 	GENERATED_BODY()
 
 protected:
-	UPROPERTY(VisibleAnywhere, Category = "GOAP")
-	TMap<FString, bool> BeliefsState;
+	FGOAPFactSet BeliefsState;
 	TMap<FString, FVector> BeliefsStateVectors;
 
 public:
 	// Non-const versions return a reference
-	TMap<FString, bool>& GetBeliefsState();
+	FGOAPFactSet& GetBeliefsState();
 	TMap<FString, FVector>& GetBeliefsStateVectors();
 	// Const versions return a const reference
-	const TMap<FString, bool>& GetBeliefsStateConst() const;
+	const FGOAPFactSet& GetBeliefsStateConst() const;
 	const TMap<FString, FVector>& GetBeliefsStateVectorsConst() const;
-	void UpdateBeliefsState(TMap<FString, bool> NewBeliefs);
+
+	/**
+	 * @return The value of the belief, or false if the agent has no belief about the fact.
+	 */
+	bool GetBelief(FGOAPFactId FactId) const;
+	bool HasBelief(FGOAPFactId FactId) const;
+	void SetBelief(FGOAPFactId FactId, bool Value);
+
+	void UpdateBeliefsState(const FGOAPFactSet& NewBeliefs);
 	void UpdateBeliefsStateVectors(TMap<FString, FVector> NewBeliefs);
-	void UpdateBeliefsState(const TPair<FString, bool>& NewBeliefs);
 	void UpdateBeliefsStateVectors(const TPair<FString, FVector>& NewBeliefs);
 	bool BeliefsMatchesWorldState( const UWorldState& WorldState)const ;
-	virtual UBeliefs* Clone();
 };
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPBlackboardSubsystem.h"
+#include "WorldState.h"
+
+UWorldState* UGOAPBlackboardSubsystem::GetBlackboard(FName Team)
+{
+	if (UWorldState* const* Blackboard = Blackboards.Find(Team))
+	{
+		return *Blackboard;
+	}
+	// Named after the team so the blackboard's facts can be told apart in the GOAP trace.
+	UWorldState* Blackboard = NewObject<UWorldState>(this, *FString::Printf(TEXT("Blackboard_%s"), *Team.ToString()));
+	Blackboards.Add(Team, Blackboard);
+	return Blackboard;
+}
+
+void UGOAPBlackboardSubsystem::PublishBlackboards()
+{
+	for (const TPair<FName, UWorldState*>& Blackboard : Blackboards)
+	{
+		Blackboard.Value->Publish();
+	}
+}
+
+void UGOAPBlackboardSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	PublishBlackboards();
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GOAPBlackboardSubsystem.generated.h"
+
+class UWorldState;
+
+/**
+ * Owns the blackboards (world states) that the GOAP agents of a world share. Every team has its own blackboard, so
+ * each world, and each PIE instance, has its own set. Writes to a blackboard are only seen once it is published,
+ * which this does once a frame after every actor has ticked.
+ */
+UCLASS()
+class AGP_API UGOAPBlackboardSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+
+	virtual TStatId GetStatId() const override
+	{
+		return TStatId();
+	}
+
+	/**
+	 * @param Team The team whose blackboard to get. Agents that don't set a team share the NAME_None blackboard.
+	 * @return The team's blackboard, which is created the first time it is asked for.
+	 */
+	UWorldState* GetBlackboard(FName Team);
+
+	/**
+	 * Will publish the writes made to every blackboard since the last time they were published.
+	 */
+	void PublishBlackboards();
+
+protected:
+
+	virtual void Tick(float DeltaTime) override;
+
+private:
+
+	UPROPERTY()
+	TMap<FName, UWorldState*> Blackboards;
+};
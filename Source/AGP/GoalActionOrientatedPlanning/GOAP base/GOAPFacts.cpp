@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPFacts.h"
+
+FGOAPFactRegistry::FGOAPFactRegistry()
+{
+	const TPair<FGOAPFactId, const TCHAR*> BuiltInFacts[] =
+	{
+		{ GOAPFacts::Player_One_Dead, TEXT("Player_One_Dead") },
+		{ GOAPFacts::Player_Two_Dead, TEXT("Player_Two_Dead") },
+		{ GOAPFacts::AllEnemiesEliminated, TEXT("AllEnemiesEliminated") },
+		{ GOAPFacts::AttackingTarget, TEXT("AttackingTarget") },
+		{ GOAPFacts::Patrolling, TEXT("Patrolling") },
+		{ GOAPFacts::Dying, TEXT("Dying") },
+		{ GOAPFacts::TargetSpotted, TEXT("TargetSpotted") },
+		{ GOAPFacts::InDangerOfDeath, TEXT("InDangerOfDeath") },
+		{ GOAPFacts::IsHealing, TEXT("IsHealing") },
+		{ GOAPFacts::HasFullHealth, TEXT("HasFullHealth") },
+		{ GOAPFacts::WithinRange, TEXT("WithinRange") },
+		{ GOAPFacts::SafeDistanceToHeal, TEXT("SafeDistanceToHeal") },
+		{ GOAPFacts::ThiefVisible, TEXT("ThiefVisible") },
+		{ GOAPFacts::ThiefLastKnownLocation, TEXT("ThiefLastKnownLocation") },
+		{ GOAPFacts::AtWaypoint, TEXT("AtWaypoint") },
+		{ GOAPFacts::GoldTaken, TEXT("GoldTaken") },
+		{ GOAPFacts::Escaped, TEXT("Escaped") },
+		{ GOAPFacts::GuardVisible, TEXT("GuardVisible") },
+		{ GOAPFacts::InCover, TEXT("InCover") },
+		{ GOAPFacts::SuppressingTarget, TEXT("SuppressingTarget") },
+		{ GOAPFacts::FlankingTarget, TEXT("FlankingTarget") },
+	};
+	static_assert(UE_ARRAY_COUNT(BuiltInFacts) == GOAPFacts::NumBuiltInFacts, "Every built in fact needs a name");
+	for (const TPair<FGOAPFactId, const TCHAR*>& Fact : BuiltInFacts)
+	{
+		const FGOAPFactId FactId = RegisterFact(Fact.Value);
+		checkf(FactId == Fact.Key, TEXT("GOAP fact %s was registered out of order"), Fact.Value);
+	}
+}
+
+FGOAPFactRegistry& FGOAPFactRegistry::Get()
+{
+	static FGOAPFactRegistry Registry;
+	return Registry;
+}
+
+FGOAPFactId FGOAPFactRegistry::RegisterFact(FName Name)
+{
+	if (const FGOAPFactId* ExistingId = FactIds.Find(Name))
+	{
+		return *ExistingId;
+	}
+	if (FactNames.Num() >= MaxFacts)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unable to register GOAP fact %s. All %d facts are in use."), *Name.ToString(),
+			MaxFacts)
+		return INDEX_NONE;
+	}
+	const FGOAPFactId FactId = FactNames.Add(Name);
+	FactIds.Add(Name, FactId);
+	return FactId;
+}
+
+FGOAPFactId FGOAPFactRegistry::FindFact(FName Name) const
+{
+	if (const FGOAPFactId* FactId = FactIds.Find(Name))
+	{
+		return *FactId;
+	}
+	UE_LOG(LogTemp, Error, TEXT("GOAP fact %s has not been registered. Check the spelling of the fact."),
+		*Name.ToString())
+	return INDEX_NONE;
+}
+
+FName FGOAPFactRegistry::GetFactName(FGOAPFactId FactId) const
+{
+	return FactNames.IsValidIndex(FactId) ? FactNames[FactId] : NAME_None;
+}
+
+FString FGOAPFactSet::ToString() const
+{
+	FString Result;
+	ForEachKnownFact([&Result](FGOAPFactId FactId, bool bValue)
+	{
+		if (!Result.IsEmpty())
+		{
+			Result += TEXT(", ");
+		}
+		Result += FString::Printf(TEXT("%s=%s"), *FGOAPFactRegistry::Get().GetFactName(FactId).ToString(),
+			bValue ? TEXT("True") : TEXT("False"));
+	});
+	return Result;
+}
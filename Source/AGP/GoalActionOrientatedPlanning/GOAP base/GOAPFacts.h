@@ -0,0 +1,307 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The small integer id that a boolean GOAP fact is interned to. Ids index directly into the bits of an FGOAPFactSet.
+ */
+using FGOAPFactId = int32;
+
+/**
+ * Interns the names of boolean GOAP facts to small integer ids. Every fact the game uses is registered once at
+ * startup (see the GOAPFacts namespace below) so that world states, beliefs, preconditions and effects can store
+ * facts as bits instead of string keyed maps. Looking up a name that was never registered is logged as an error,
+ * so a misspelt fact is caught rather than silently creating a new, unrelated one.
+ */
+class AGP_API FGOAPFactRegistry
+{
+public:
+	// Facts are stored in 64 bit words so this is the number of facts a fact set can hold.
+	static constexpr int32 MaxFacts = 128;
+
+	static FGOAPFactRegistry& Get();
+
+	/**
+	 * Will intern a fact, or return its existing id if it has already been registered. This should only be called
+	 * during startup as the registry is read by planners without any locking.
+	 * @param Name The name of the fact.
+	 * @return The id of the fact, or INDEX_NONE if the registry is full.
+	 */
+	FGOAPFactId RegisterFact(FName Name);
+
+	/**
+	 * @param Name The name of a registered fact.
+	 * @return The id of the fact, or INDEX_NONE (with an error logged) if no fact with this name was registered.
+	 */
+	FGOAPFactId FindFact(FName Name) const;
+
+	/**
+	 * @return The name the fact was registered with, or NAME_None if the id is invalid.
+	 */
+	FName GetFactName(FGOAPFactId FactId) const;
+
+	int32 GetNumFacts() const { return FactNames.Num(); }
+
+private:
+	FGOAPFactRegistry();
+
+	TMap<FName, FGOAPFactId> FactIds;
+	TArray<FName> FactNames;
+};
+
+/**
+ * The ids of every fact used by the GOAP agents. The ids are fixed so they can be used in constant expressions, such as
+ * the action descriptors, and the registry registers their names first and in this order so the names line up. New
+ * facts have to be added to the end of the list and to the registry's constructor.
+ */
+namespace GOAPFacts
+{
+	// Shared world facts.
+	inline constexpr FGOAPFactId Player_One_Dead = 0;
+	inline constexpr FGOAPFactId Player_Two_Dead = 1;
+	inline constexpr FGOAPFactId AllEnemiesEliminated = 2;
+	inline constexpr FGOAPFactId AttackingTarget = 3;
+	inline constexpr FGOAPFactId Patrolling = 4;
+	inline constexpr FGOAPFactId Dying = 5;
+
+	// Enemy facts.
+	inline constexpr FGOAPFactId TargetSpotted = 6;
+	inline constexpr FGOAPFactId InDangerOfDeath = 7;
+	inline constexpr FGOAPFactId IsHealing = 8;
+	inline constexpr FGOAPFactId HasFullHealth = 9;
+	inline constexpr FGOAPFactId WithinRange = 10;
+	inline constexpr FGOAPFactId SafeDistanceToHeal = 11;
+
+	// Thief and patrol facts.
+	inline constexpr FGOAPFactId ThiefVisible = 12;
+	inline constexpr FGOAPFactId ThiefLastKnownLocation = 13;
+	inline constexpr FGOAPFactId AtWaypoint = 14;
+	inline constexpr FGOAPFactId GoldTaken = 15;
+	inline constexpr FGOAPFactId Escaped = 16;
+	inline constexpr FGOAPFactId GuardVisible = 17;
+
+	// Enemy squad facts. Squads plan with them too, where they mean that some member of the squad has them.
+	inline constexpr FGOAPFactId InCover = 18;
+	inline constexpr FGOAPFactId SuppressingTarget = 19;
+	inline constexpr FGOAPFactId FlankingTarget = 20;
+
+	inline constexpr int32 NumBuiltInFacts = 21;
+}
+
+/**
+ * A set of boolean facts stored as two bitsets: which facts are known and, for the known facts, their values. The
+ * same struct is used for conditions (preconditions and goal states), where the known bits are the mask of facts
+ * that are tested and the values are what they have to be. Testing and applying a whole set is a handful of word
+ * wide AND/OR operations no matter how many facts are involved.
+ */
+struct AGP_API FGOAPFactSet
+{
+	static constexpr int32 NumWords = FGOAPFactRegistry::MaxFacts / 64;
+
+	uint64 Known[NumWords] = {};
+	uint64 Values[NumWords] = {};
+
+	static constexpr bool IsValidFact(FGOAPFactId FactId) { return FactId >= 0 && FactId < FGOAPFactRegistry::MaxFacts; }
+
+	/**
+	 * Will set the fact to the given value and mark it as known.
+	 */
+	constexpr void Set(FGOAPFactId FactId, bool bValue)
+	{
+		if (!IsValidFact(FactId)) return;
+		const int32 Word = GetWord(FactId);
+		const uint64 Bit = GetBit(FactId);
+		Known[Word] |= Bit;
+		Values[Word] = bValue ? Values[Word] | Bit : Values[Word] & ~Bit;
+	}
+
+	/**
+	 * Will mark the fact as unknown again.
+	 */
+	constexpr void Forget(FGOAPFactId FactId)
+	{
+		if (!IsValidFact(FactId)) return;
+		Known[GetWord(FactId)] &= ~GetBit(FactId);
+		Values[GetWord(FactId)] &= ~GetBit(FactId);
+	}
+
+	constexpr bool IsKnown(FGOAPFactId FactId) const
+	{
+		return IsValidFact(FactId) && (Known[GetWord(FactId)] & GetBit(FactId)) != 0;
+	}
+
+	/**
+	 * @return The value of the fact, or false if it isn't known.
+	 */
+	constexpr bool Get(FGOAPFactId FactId) const
+	{
+		return IsValidFact(FactId) && (Values[GetWord(FactId)] & GetBit(FactId)) != 0;
+	}
+
+	/**
+	 * Facts that aren't known here are treated as false, the same as Get does.
+	 * @param Conditions The facts to test, where the known bits are the mask of facts to check.
+	 * @return True if every fact in the conditions has the same value here.
+	 */
+	constexpr bool Satisfies(const FGOAPFactSet& Conditions) const
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			if (((Values[Word] ^ Conditions.Values[Word]) & Conditions.Known[Word]) != 0) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @return The number of facts in the conditions that don't have the same value here.
+	 */
+	int32 CountUnsatisfied(const FGOAPFactSet& Conditions) const
+	{
+		int32 Count = 0;
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			Count += FMath::CountBits((Values[Word] ^ Conditions.Values[Word]) & Conditions.Known[Word]);
+		}
+		return Count;
+	}
+
+	/**
+	 * @return True if every fact that is known in both sets has the same value in both.
+	 */
+	constexpr bool Agrees(const FGOAPFactSet& Other) const
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			if (((Values[Word] ^ Other.Values[Word]) & Known[Word] & Other.Known[Word]) != 0) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Will overwrite every fact that is known in the effects with its value there.
+	 */
+	constexpr void Apply(const FGOAPFactSet& Effects)
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			Values[Word] = (Values[Word] & ~Effects.Known[Word]) | (Effects.Values[Word] & Effects.Known[Word]);
+			Known[Word] |= Effects.Known[Word];
+		}
+	}
+
+	/**
+	 * @return A set whose known bits are the facts that were known in only one of the two sets or have a different
+	 * value in each. The values of the returned set are all false.
+	 */
+	FGOAPFactSet GetChangedFacts(const FGOAPFactSet& Other) const
+	{
+		FGOAPFactSet Changed;
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			Changed.Known[Word] = (Known[Word] ^ Other.Known[Word]) | (Values[Word] ^ Other.Values[Word]);
+		}
+		return Changed;
+	}
+
+	/**
+	 * Will mark every fact that is known in the other set as known here, leaving the values alone. Used to build up a
+	 * mask of facts.
+	 */
+	constexpr void AddKnownFacts(const FGOAPFactSet& Other)
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			Known[Word] |= Other.Known[Word];
+		}
+	}
+
+	/**
+	 * @return The facts of this set that are known in the mask, with their values.
+	 */
+	constexpr FGOAPFactSet GetMasked(const FGOAPFactSet& Mask) const
+	{
+		FGOAPFactSet Masked;
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			Masked.Known[Word] = Known[Word] & Mask.Known[Word];
+			Masked.Values[Word] = Values[Word] & Mask.Known[Word];
+		}
+		return Masked;
+	}
+
+	/**
+	 * @return True if any fact is known in both sets.
+	 */
+	constexpr bool SharesKnownFacts(const FGOAPFactSet& Other) const
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			if ((Known[Word] & Other.Known[Word]) != 0) return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @return The number of known facts.
+	 */
+	int32 Num() const
+	{
+		int32 Count = 0;
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			Count += FMath::CountBits(Known[Word]);
+		}
+		return Count;
+	}
+
+	constexpr bool IsEmpty() const
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			if (Known[Word] != 0) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Will call Function(FactId, bValue) for every known fact, in id order.
+	 */
+	template<typename FunctionType>
+	void ForEachKnownFact(const FunctionType& Function) const
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			uint64 Remaining = Known[Word];
+			while (Remaining != 0)
+			{
+				const int32 Bit = FMath::CountTrailingZeros64(Remaining);
+				Remaining &= Remaining - 1;
+				const FGOAPFactId FactId = Word * 64 + Bit;
+				Function(FactId, Get(FactId));
+			}
+		}
+	}
+
+	bool operator==(const FGOAPFactSet& Other) const
+	{
+		return FMemory::Memcmp(this, &Other, sizeof(FGOAPFactSet)) == 0;
+	}
+
+	bool operator!=(const FGOAPFactSet& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FGOAPFactSet& FactSet)
+	{
+		return FCrc::MemCrc32(&FactSet, sizeof(FGOAPFactSet));
+	}
+
+	/**
+	 * @return The known facts as "Name=True, Name=False" for logging.
+	 */
+	FString ToString() const;
+
+private:
+	static constexpr int32 GetWord(FGOAPFactId FactId) { return FactId / 64; }
+	static constexpr uint64 GetBit(FGOAPFactId FactId) { return uint64(1) << (FactId % 64); }
+};
@@ -3,15 +3,14 @@
 
 #include "GOAPGameMode.h"
 
-#include "WorldState.h"
+#include "Agent.h"
+#include "GOAPBlackboardSubsystem.h"
+#include "GOAPPlanningSubsystem.h"
 
-AGOAPGameMode::AGOAPGameMode(const FObjectInitializer& ObjectInitializer) 
+AGOAPGameMode::AGOAPGameMode(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
-
-	// Properly create WorldState as a default subobject
-	WorldState = ObjectInitializer.CreateDefaultSubobject<UWorldState>(this, TEXT("WorldState"));
 }
 
 void AGOAPGameMode::BeginPlay()
@@ -25,12 +24,16 @@ void AGOAPGameMode::RegisterAgent(UAgent* NewAgent)
 	{
 		if(!ActiveAgents.Contains(NewAgent))
 			ActiveAgents.Add(NewAgent);
+		if (UGOAPPlanningSubsystem* PlanningSubsystem = GetWorld()->GetSubsystem<UGOAPPlanningSubsystem>())
+		{
+			PlanningSubsystem->RegisterAgent(NewAgent);
+		}
 	}
 }
 
-UWorldState* AGOAPGameMode::GetWorldState() const
+UWorldState* AGOAPGameMode::GetWorldState(FName Team) const
 {
-	return WorldState;
+	return GetWorld()->GetSubsystem<UGOAPBlackboardSubsystem>()->GetBlackboard(Team);
 }
 
 void AGOAPGameMode::Tick(float DeltaSeconds)
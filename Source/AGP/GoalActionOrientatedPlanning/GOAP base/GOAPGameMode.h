@@ -8,8 +8,9 @@
 
 class UAgent;
 class UWorldState;
+
 /**
- * 
+ * Planning is scheduled by the world's UGOAPPlanningSubsystem, so the agents don't depend on this game mode.
  */
 UCLASS()
 class AGP_API AGOAPGameMode : public AGameModeBase
@@ -23,18 +24,17 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
-private: 
-	UPROPERTY(VisibleAnywhere)
-	UWorldState* WorldState; 
+private:
 	UPROPERTY(VisibleAnywhere)
 	TArray<UAgent*> ActiveAgents;
+
 public:
 
-	// Function to register an agent in the game mode
+	// Function to register an agent in the game mode. Its planning is scheduled by the world's planning subsystem.
 	void RegisterAgent(UAgent* NewAgent);
 
-	// Function to get the current world state
-	UWorldState* GetWorldState() const;
+	// Function to get a team's blackboard, which is owned by the world's UGOAPBlackboardSubsystem
+	UWorldState* GetWorldState(FName Team = NAME_None) const;
 
 	// Tick function to allow GameMode to run logic per frame
 	virtual void Tick(float DeltaSeconds) override;
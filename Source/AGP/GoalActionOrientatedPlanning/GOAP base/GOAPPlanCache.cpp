@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPPlanCache.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	FAutoConsoleCommand PlanCacheStatsCommand(
+		TEXT("GOAP.PlanCacheStats"),
+		TEXT("Logs how many searches the shared GOAP plan cache holds and how often agents found their plan in it."),
+		FConsoleCommandDelegate::CreateLambda([]() { FGOAPPlanCache::Get().LogStats(); }));
+
+	FAutoConsoleCommand ClearPlanCacheCommand(
+		TEXT("GOAP.ClearPlanCache"),
+		TEXT("Throws away every search in the shared GOAP plan cache."),
+		FConsoleCommandDelegate::CreateLambda([]() { FGOAPPlanCache::Get().Invalidate(); }));
+}
+
+FGOAPPlanCache& FGOAPPlanCache::Get()
+{
+	static FGOAPPlanCache Cache;
+	return Cache;
+}
+
+bool FGOAPPlanCache::Find(const FGOAPPlanCacheKey& Key, FGOAPCachedPlan& OutPlan)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (const FGOAPCachedPlan* Plan = Entries.FindAndTouch(Key))
+	{
+		OutPlan = *Plan;
+		NumHits++;
+		return true;
+	}
+	NumMisses++;
+	return false;
+}
+
+void FGOAPPlanCache::Add(const FGOAPPlanCacheKey& Key, const FGOAPCachedPlan& Plan)
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Add(Key, Plan);
+}
+
+void FGOAPPlanCache::Invalidate()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty(MaxEntries);
+	NumHits = 0;
+	NumMisses = 0;
+}
+
+void FGOAPPlanCache::LogStats()
+{
+	FScopeLock ScopeLock(&Lock);
+	const int64 NumLookups = NumHits + NumMisses;
+	UE_LOG(LogTemp, Display, TEXT("GOAP plan cache: %d/%d entries, %lld hits and %lld misses, %.1f%% hit rate"),
+		Entries.Num(), MaxEntries, NumHits, NumMisses, NumLookups > 0 ? 100.0 * NumHits / NumLookups : 0.0)
+}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GOAPFacts.h"
+#include "Containers/LruCache.h"
+
+/**
+ * Identifies a search by everything its result depends on. Agents with the same kind of actions, searching for the
+ * same goal state from the same relevant facts, get the same key and so can share the result.
+ */
+struct FGOAPPlanCacheKey
+{
+	// A hash of the class, facts and cost of every action, in order. Changing an agent's actions changes this.
+	uint32 DomainHash = 0;
+	int32 NumActions = 0;
+	FGOAPFactSet GoalState;
+	// The start facts, masked to the facts that the actions and the goal can read or write.
+	FGOAPFactSet Facts;
+	// Which actions passed their context check, so which ones the plan can start with.
+	uint64 PossibleNowMask = 0;
+	int32 MaxDepth = 0;
+	int32 MaxNodes = 0;
+	bool bAllowPartialPlan = false;
+
+	bool operator==(const FGOAPPlanCacheKey& Other) const
+	{
+		return DomainHash == Other.DomainHash && NumActions == Other.NumActions && GoalState == Other.GoalState &&
+			Facts == Other.Facts && PossibleNowMask == Other.PossibleNowMask && MaxDepth == Other.MaxDepth &&
+			MaxNodes == Other.MaxNodes && bAllowPartialPlan == Other.bAllowPartialPlan;
+	}
+
+	friend uint32 GetTypeHash(const FGOAPPlanCacheKey& Key)
+	{
+		uint32 Hash = HashCombine(Key.DomainHash, GetTypeHash(Key.GoalState));
+		Hash = HashCombine(Hash, GetTypeHash(Key.Facts));
+		return HashCombine(Hash, GetTypeHash(Key.PossibleNowMask));
+	}
+};
+
+/**
+ * The result of a search. The actions are stored as indices into the action array, so a result can be handed to any
+ * agent whose actions have the same key, whichever action objects it was made with.
+ */
+struct FGOAPCachedPlan
+{
+	TArray<uint8, TInlineAllocator<8>> ActionIndices;
+	float PlanCost = 0.0f;
+	// True if the plan only gets closer to the goal, and how many goal facts it leaves unsatisfied.
+	bool bPartial = false;
+	int32 UnsatisfiedGoalFacts = 0;
+};
+
+/**
+ * A bounded cache of search results shared by every agent. Agents spawned together usually have the same actions and
+ * goals and often the same beliefs, so most of them would otherwise run the exact same searches. The least recently
+ * used results are thrown away once the cache is full. Results are never stale, as any change to an agent's actions
+ * or to the facts that they read changes the key, so entries made for an old set of actions simply stop being found.
+ * Searches run on worker threads, so every call takes a lock.
+ */
+class AGP_API FGOAPPlanCache
+{
+public:
+	static constexpr int32 MaxEntries = 1024;
+
+	// The most actions a domain can have for its searches to be cached, one bit each in the PossibleNowMask.
+	static constexpr int32 MaxActions = 64;
+
+	static FGOAPPlanCache& Get();
+
+	/**
+	 * @param Key The search to look up.
+	 * @param OutPlan Will be set to the result of the search if it is cached.
+	 * @return True if the search is cached.
+	 */
+	bool Find(const FGOAPPlanCacheKey& Key, FGOAPCachedPlan& OutPlan);
+
+	void Add(const FGOAPPlanCacheKey& Key, const FGOAPCachedPlan& Plan);
+
+	/**
+	 * Will throw away every cached result and reset the hit counts.
+	 */
+	void Invalidate();
+
+	/**
+	 * Will log the number of entries and the hit rate since the cache was last invalidated.
+	 */
+	void LogStats();
+
+private:
+	FGOAPPlanCache() : Entries(MaxEntries) {}
+
+	FCriticalSection Lock;
+	TLruCache<FGOAPPlanCacheKey, FGOAPCachedPlan> Entries;
+	int64 NumHits = 0;
+	int64 NumMisses = 0;
+};
@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPPlanningSubsystem.h"
+
+#include "Agent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	float PlanningBudgetMs = 1.0f;
+	FAutoConsoleVariableRef PlanningBudgetMsVariable(
+		TEXT("GOAP.PlanningBudgetMs"),
+		PlanningBudgetMs,
+		TEXT("The time in milliseconds that can be spent planning each frame. At least one agent is always planned ")
+		TEXT("for each frame so that planning can't stall, unless GOAP.MaxPlanningJobs searches are already running."));
+
+	float NearPlayerDistance = 3000.0f;
+	FAutoConsoleVariableRef NearPlayerDistanceVariable(
+		TEXT("GOAP.NearPlayerDistance"),
+		NearPlayerDistance,
+		TEXT("Agents within this distance of a player are planned for before agents further away."));
+
+	bool bParallelPlanning = true;
+	FAutoConsoleVariableRef ParallelPlanningVariable(
+		TEXT("GOAP.ParallelPlanning"),
+		bParallelPlanning,
+		TEXT("If true the searches run on worker threads and their plans are committed the next frame. Otherwise each ")
+		TEXT("agent is planned for on the game thread straight away."));
+
+	int32 MaxPlanningJobs = 8;
+	FAutoConsoleVariableRef MaxPlanningJobsVariable(
+		TEXT("GOAP.MaxPlanningJobs"),
+		MaxPlanningJobs,
+		TEXT("When planning in parallel only the snapshots are timed against the budget, so this caps how many ")
+		TEXT("searches can run at once instead. Agents that don't fit wait until a search finishes."));
+
+	int32 FallbackSearchNodes = 64;
+	FAutoConsoleVariableRef FallbackSearchNodesVariable(
+		TEXT("GOAP.FallbackSearchNodes"),
+		FallbackSearchNodes,
+		TEXT("Agents with no plan at all that don't fit in the planning budget still get a search limited to this many ")
+		TEXT("nodes, which returns a partial plan if it can't finish, so no agent is left standing still. 0 leaves ")
+		TEXT("them waiting."));
+}
+
+void UGOAPPlanningSubsystem::Deinitialize()
+{
+	// Waits for the searches still running so none of them outlive the world.
+	for (FGOAPPlanningJob& Job : PlanningJobs)
+	{
+		Job.Task.Wait();
+	}
+	CommitPlanningJobs();
+
+	for (UAgent* Agent : ActiveAgents)
+	{
+		if (IsValid(Agent))
+		{
+			Agent->SetScheduler(nullptr);
+		}
+	}
+	ActiveAgents.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGOAPPlanningSubsystem::RegisterAgent(UAgent* Agent)
+{
+	if (Agent)
+	{
+		ActiveAgents.AddUnique(Agent);
+		Agent->SetScheduler(this);
+	}
+}
+
+void UGOAPPlanningSubsystem::UnregisterAgent(UAgent* Agent)
+{
+	if (Agent)
+	{
+		ActiveAgents.Remove(Agent);
+		Agent->SetScheduler(nullptr);
+	}
+}
+
+void UGOAPPlanningSubsystem::Tick(float DeltaTime)
+{
+	CommitPlanningJobs();
+	ScheduleAgentPlanning();
+}
+
+void UGOAPPlanningSubsystem::CommitPlanningJobs()
+{
+	for (int32 Index = 0; Index < PlanningJobs.Num(); )
+	{
+		// Searches that haven't finished are left for a later frame rather than stalling this one.
+		if (!PlanningJobs[Index].Task.IsCompleted())
+		{
+			Index++;
+			continue;
+		}
+
+		FGOAPPlanningJob Job = MoveTemp(PlanningJobs[Index]);
+		PlanningJobs.RemoveAtSwap(Index);
+		if (UAgent* Agent = Job.Agent.Get())
+		{
+			Agent->CommitPlan(Job.Task.GetResult());
+		}
+	}
+}
+
+void UGOAPPlanningSubsystem::ScheduleAgentPlanning()
+{
+	ActiveAgents.RemoveAll([](const UAgent* Agent) { return !IsValid(Agent); });
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APawn* Pawn = Iterator->IsValid() ? (*Iterator)->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	struct FPendingAgent
+	{
+		UAgent* Agent;
+		bool bNeedsNewPlan;
+		bool bNearPlayer;
+		double LastPlanTime;
+	};
+	TArray<FPendingAgent> PendingAgents;
+	for (UAgent* Agent : ActiveAgents)
+	{
+		if (!Agent->IsPlanPending() || Agent->IsPlanInFlight()) continue;
+
+		bool bNearPlayer = false;
+		if (const AActor* Owner = Agent->GetOwner())
+		{
+			for (const FVector& PlayerLocation : PlayerLocations)
+			{
+				if (FVector::DistSquared(Owner->GetActorLocation(), PlayerLocation) <= FMath::Square(NearPlayerDistance))
+				{
+					bNearPlayer = true;
+					break;
+				}
+			}
+		}
+		PendingAgents.Add({ Agent, Agent->NeedsNewPlan(), bNearPlayer, Agent->GetLastPlanTime() });
+	}
+
+	PendingAgents.Sort([](const FPendingAgent& A, const FPendingAgent& B)
+	{
+		if (A.bNeedsNewPlan != B.bNeedsNewPlan) return A.bNeedsNewPlan;
+		if (A.bNearPlayer != B.bNearPlayer) return A.bNearPlayer;
+		return A.LastPlanTime < B.LastPlanTime;
+	});
+
+	// Agents that don't fit in this frame keep their request, and as they are now the ones that have waited the
+	// longest they are planned for first the next time round.
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = PlanningBudgetMs / 1000.0;
+	NumAgentsPlannedLastFrame = 0;
+	for (const FPendingAgent& PendingAgent : PendingAgents)
+	{
+		if (bParallelPlanning && PlanningJobs.Num() >= FMath::Max(MaxPlanningJobs, 1)) break;
+
+		// Over budget, only agents that would otherwise have nothing to do are planned for, and only with a small
+		// search. Agents with a plan sort after them, so the rest can stop here.
+		int32 MaxSearchNodes = 0;
+		if (NumAgentsPlannedLastFrame > 0 && FPlatformTime::Seconds() - StartTime >= Budget)
+		{
+			if (!PendingAgent.bNeedsNewPlan || FallbackSearchNodes <= 0) break;
+			MaxSearchNodes = FallbackSearchNodes;
+		}
+
+		UAgent* Agent = PendingAgent.Agent;
+		if (bParallelPlanning)
+		{
+			// The buffers are shared with the task so they outlive the agent if it is destroyed mid search.
+			TSharedRef<FGOAPSearchBuffers, ESPMode::ThreadSafe> Buffers = Agent->GetPlanner()->GetSearchBuffers();
+			PlanningJobs.Add({ Agent, UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[Snapshot = Agent->CapturePlanSnapshot(MaxSearchNodes), Buffers]()
+				{
+					return UPlanner::ChooseBestPlan(Snapshot, *Buffers);
+				}) });
+		}
+		else if (MaxSearchNodes > 0)
+		{
+			Agent->CommitPlan(UPlanner::ChooseBestPlan(Agent->CapturePlanSnapshot(MaxSearchNodes),
+				*Agent->GetPlanner()->GetSearchBuffers()));
+		}
+		else
+		{
+			Agent->PlanActions();
+		}
+		NumAgentsPlannedLastFrame++;
+	}
+	NumAgentsWaitingLastFrame = PendingAgents.Num() - NumAgentsPlannedLastFrame;
+}
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Planner.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "GOAPPlanningSubsystem.generated.h"
+
+class UAgent;
+
+/**
+ * A plan being made on a worker thread for an agent.
+ */
+struct FGOAPPlanningJob
+{
+	TWeakObjectPtr<UAgent> Agent;
+	UE::Tasks::TTask<FGOAPPlanResult> Task;
+};
+
+/**
+ * Schedules the planning of every GOAP agent in a world, whatever the game mode is. Agents that need a new plan ask
+ * for one and keep executing their current plan while they wait. Each frame the subsystem takes snapshots of as many
+ * of the waiting agents as fit in the planning budget, so the cost of planning per frame stays the same however many
+ * agents there are. The searches run in parallel on worker threads and each plan is handed to its agent on the first
+ * frame after its search finishes.
+ *
+ * The budget and limits are set with the GOAP.PlanningBudgetMs, GOAP.NearPlayerDistance, GOAP.ParallelPlanning,
+ * GOAP.MaxPlanningJobs and GOAP.FallbackSearchNodes console variables.
+ */
+UCLASS()
+class AGP_API UGOAPPlanningSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+
+	virtual TStatId GetStatId() const override
+	{
+		return TStatId();
+	}
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Will take over deciding when the agent plans.
+	 */
+	void RegisterAgent(UAgent* Agent);
+
+	/**
+	 * Stops scheduling the agent's planning. The agent plans by itself again afterwards.
+	 */
+	void UnregisterAgent(UAgent* Agent);
+
+	int32 GetNumAgentsPlannedLastFrame() const { return NumAgentsPlannedLastFrame; }
+	int32 GetNumAgentsWaitingLastFrame() const { return NumAgentsWaitingLastFrame; }
+
+protected:
+
+	virtual void Tick(float DeltaTime) override;
+
+private:
+
+	UPROPERTY()
+	TArray<UAgent*> ActiveAgents;
+
+	// How many agents were planned for and how many were left waiting in the last frame.
+	int32 NumAgentsPlannedLastFrame = 0;
+	int32 NumAgentsWaitingLastFrame = 0;
+
+	// The plans that have been started and not handed to their agents yet.
+	TArray<FGOAPPlanningJob> PlanningJobs;
+
+	/**
+	 * Will hand the plans whose searches have finished to their agents. Searches still running are left for a later
+	 * frame, and their agents keep executing their old plans until then.
+	 */
+	void CommitPlanningJobs();
+
+	/**
+	 * Will plan for the agents that asked for a plan until the planning budget runs out. Agents without a usable plan
+	 * go first, then agents near a player, then the agents that have waited the longest since they last planned. Only
+	 * the snapshots count towards the budget when planning in parallel, as that is all that runs on the game thread,
+	 * and no more than GOAP.MaxPlanningJobs searches are started or left running. Agents without a plan that are left
+	 * over get a small search limited to GOAP.FallbackSearchNodes.
+	 */
+	void ScheduleAgentPlanning();
+};
@@ -0,0 +1,236 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(GOAPChannel)
+
+UE_TRACE_EVENT_BEGIN(GOAP, Decision)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Event)
+	UE_TRACE_EVENT_FIELD(int32, Value)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Agent)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Subject)
+UE_TRACE_EVENT_END()
+
+namespace
+{
+	// Written at the start of trace files, followed by the version of the record layout.
+	constexpr uint32 TraceFileMagic = 0x50414F47;
+	constexpr int32 TraceFileVersion = 1;
+
+	bool bTraceEnabled = false;
+	FAutoConsoleVariableRef TraceEnabledVariable(
+		TEXT("GOAP.Trace"),
+		bTraceEnabled,
+		TEXT("If true the decisions of the GOAP agents are recorded into the trace buffer. See GOAP.DumpTrace."));
+
+	int32 TraceCapacity = 16384;
+	FAutoConsoleVariableRef TraceCapacityVariable(
+		TEXT("GOAP.TraceCapacity"),
+		TraceCapacity,
+		TEXT("How many decisions the GOAP trace buffer holds before the oldest are overwritten. Changing this clears ")
+		TEXT("the buffer."));
+
+	// Cached as a name so that filtering a record is a single comparison.
+	FName TraceAgentFilter;
+	FString TraceAgent;
+	FAutoConsoleVariableRef TraceAgentVariable(
+		TEXT("GOAP.TraceAgent"),
+		TraceAgent,
+		TEXT("Only the decisions of the agent owned by the actor with this name (or of the blackboard with this name) ")
+		TEXT("are traced. Leave empty to trace every agent."),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+		{
+			TraceAgentFilter = TraceAgent.IsEmpty() ? NAME_None : FName(*TraceAgent);
+		}));
+
+	FAutoConsoleCommand DumpTraceCommand(
+		TEXT("GOAP.DumpTrace"),
+		TEXT("Writes the GOAP trace buffer to a file, Saved/GOAPTrace/GOAPTrace-<time>.bin unless a path is given. ")
+		TEXT("Read it with -run=GOAPTraceDump -File=<path>."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("GOAPTrace") /
+				FString::Printf(TEXT("GOAPTrace-%s.bin"), *FDateTime::Now().ToString());
+			if (FGOAPTrace::Get().WriteFile(Filename))
+			{
+				UE_LOG(LogTemp, Display, TEXT("GOAP trace written to %s"), *Filename)
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("Unable to write the GOAP trace to %s"), *Filename)
+			}
+		}));
+
+	FAutoConsoleCommand ClearTraceCommand(
+		TEXT("GOAP.ClearTrace"),
+		TEXT("Throws away every decision in the GOAP trace buffer."),
+		FConsoleCommandDelegate::CreateLambda([]() { FGOAPTrace::Get().Clear(); }));
+
+	const TCHAR* GetEventName(EGOAPTraceEvent Event)
+	{
+		switch (Event)
+		{
+		case EGOAPTraceEvent::GoalChanged: return TEXT("GoalChanged");
+		case EGOAPTraceEvent::PlanCommitted: return TEXT("PlanCommitted");
+		case EGOAPTraceEvent::PlanStep: return TEXT("PlanStep");
+		case EGOAPTraceEvent::ActionStarted: return TEXT("ActionStarted");
+		case EGOAPTraceEvent::ActionFinished: return TEXT("ActionFinished");
+		case EGOAPTraceEvent::FactChanged: return TEXT("FactChanged");
+		}
+		return TEXT("Unknown");
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FGOAPTraceRecord& Record)
+{
+	uint8 Event = static_cast<uint8>(Record.Event);
+	Ar << Record.Time << Record.Frame << Event << Record.Value << Record.Agent << Record.Subject;
+	Record.Event = static_cast<EGOAPTraceEvent>(Event);
+	return Ar;
+}
+
+FString FGOAPTraceRecord::ToString(double StartTime) const
+{
+	FString Details;
+	switch (Event)
+	{
+	case EGOAPTraceEvent::PlanCommitted:
+		Details = FString::Printf(TEXT("%s, %d actions"), *Subject.ToString(), Value);
+		break;
+	case EGOAPTraceEvent::PlanStep:
+		Details = FString::Printf(TEXT("%d: %s"), Value, *Subject.ToString());
+		break;
+	case EGOAPTraceEvent::ActionFinished:
+		Details = FString::Printf(TEXT("%s (%s)"), *Subject.ToString(), Value ? TEXT("completed") : TEXT("abandoned"));
+		break;
+	case EGOAPTraceEvent::FactChanged:
+		Details = FString::Printf(TEXT("%s = %s"), *Subject.ToString(), Value ? TEXT("True") : TEXT("False"));
+		break;
+	default:
+		Details = Subject.ToString();
+		break;
+	}
+	return FString::Printf(TEXT("%10.3f  frame %-8u %-24s %-14s %s"), Time - StartTime, Frame, *Agent.ToString(),
+		GetEventName(Event), *Details);
+}
+
+FGOAPTrace& FGOAPTrace::Get()
+{
+	static FGOAPTrace Trace;
+	return Trace;
+}
+
+bool FGOAPTrace::IsTracing(FName Agent)
+{
+#if GOAP_TRACE_ENABLED
+	const bool bInsightsTracing = UE_TRACE_CHANNELEXPR_IS_ENABLED(GOAPChannel);
+	return (bTraceEnabled || bInsightsTracing) && (TraceAgentFilter.IsNone() || TraceAgentFilter == Agent);
+#else
+	return false;
+#endif
+}
+
+void FGOAPTrace::RecordFactChanges(FName Agent, const FGOAPFactSet& OldFacts, const FGOAPFactSet& NewFacts)
+{
+#if GOAP_TRACE_ENABLED
+	if (!IsTracing(Agent)) return;
+
+	OldFacts.GetChangedFacts(NewFacts).ForEachKnownFact([Agent, &NewFacts](FGOAPFactId FactId, bool)
+	{
+		Get().Add(EGOAPTraceEvent::FactChanged, Agent, FGOAPFactRegistry::Get().GetFactName(FactId),
+			NewFacts.Get(FactId));
+	});
+#endif
+}
+
+void FGOAPTrace::Add(EGOAPTraceEvent Event, FName Agent, FName Subject, int32 Value)
+{
+	checkSlow(IsInGameThread());
+
+	UE_TRACE_LOG(GOAP, Decision, GOAPChannel)
+		<< Decision.Cycle(FPlatformTime::Cycles64())
+		<< Decision.Event(static_cast<uint8>(Event))
+		<< Decision.Value(Value)
+		<< Decision.Agent(*Agent.ToString())
+		<< Decision.Subject(*Subject.ToString());
+
+	if (!bTraceEnabled) return;
+
+	const int32 NewCapacity = FMath::Max(TraceCapacity, 1);
+	if (NewCapacity != Capacity)
+	{
+		Records.Empty(NewCapacity);
+		NextRecord = 0;
+		Capacity = NewCapacity;
+	}
+
+	FGOAPTraceRecord Record;
+	Record.Time = FPlatformTime::Seconds();
+	Record.Frame = static_cast<uint32>(GFrameCounter);
+	Record.Event = Event;
+	Record.Value = Value;
+	Record.Agent = Agent;
+	Record.Subject = Subject;
+
+	if (Records.Num() < Capacity)
+	{
+		Records.Add(Record);
+	}
+	else
+	{
+		Records[NextRecord] = Record;
+	}
+	NextRecord = (NextRecord + 1) % Capacity;
+}
+
+void FGOAPTrace::GetRecords(TArray<FGOAPTraceRecord>& OutRecords) const
+{
+	// Until the buffer is full NextRecord is also the number of records, so the records start at index 0.
+	const int32 Oldest = NextRecord % FMath::Max(Records.Num(), 1);
+	OutRecords.Reset(Records.Num());
+	OutRecords.Append(Records.GetData() + Oldest, Records.Num() - Oldest);
+	OutRecords.Append(Records.GetData(), Oldest);
+}
+
+void FGOAPTrace::Clear()
+{
+	Records.Empty();
+	NextRecord = 0;
+}
+
+bool FGOAPTrace::WriteFile(const FString& Filename) const
+{
+	TArray<FGOAPTraceRecord> OrderedRecords;
+	GetRecords(OrderedRecords);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = TraceFileMagic;
+	int32 Version = TraceFileVersion;
+	Writer << Magic << Version << OrderedRecords;
+	return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FGOAPTrace::ReadFile(const FString& Filename, TArray<FGOAPTraceRecord>& OutRecords)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename)) return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != TraceFileMagic || Version != TraceFileVersion) return false;
+
+	Reader << OutRecords;
+	return !Reader.IsError();
+}
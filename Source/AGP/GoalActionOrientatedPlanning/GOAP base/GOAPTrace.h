@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GOAPFacts.h"
+
+// The trace is compiled out of shipping builds, where recording is a no-op.
+#ifndef GOAP_TRACE_ENABLED
+#define GOAP_TRACE_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * The kinds of decision the GOAP trace records.
+ */
+enum class EGOAPTraceEvent : uint8
+{
+	// Subject is the new goal.
+	GoalChanged,
+	// Subject is the goal planned for and Value the number of actions in the plan.
+	PlanCommitted,
+	// Subject is an action of the plan just committed and Value its position in the plan.
+	PlanStep,
+	// Subject is the action.
+	ActionStarted,
+	ActionFinished,
+	// Subject is the fact and Value its new value. Flips of a blackboard are recorded against the blackboard.
+	FactChanged,
+};
+
+/**
+ * One decision in the trace. Records are plain data, so recording one is a copy into the ring buffer with no string
+ * formatting. Names are only turned into strings when the trace is dumped.
+ */
+struct FGOAPTraceRecord
+{
+	double Time = 0.0;
+	uint32 Frame = 0;
+	EGOAPTraceEvent Event = EGOAPTraceEvent::GoalChanged;
+	int32 Value = 0;
+	// The actor the agent belongs to, or the blackboard for blackboard facts.
+	FName Agent;
+	FName Subject;
+
+	friend FArchive& operator<<(FArchive& Ar, FGOAPTraceRecord& Record);
+
+	/**
+	 * @return The record as one line of text, with its time relative to StartTime.
+	 */
+	FString ToString(double StartTime) const;
+};
+
+/**
+ * Records the decisions the GOAP agents make (goal changes, plans, actions starting and finishing and facts flipping)
+ * into a fixed size ring buffer, so the last few thousand decisions can be looked at after something has gone wrong
+ * without logging every tick. Recording is turned on with the GOAP.Trace console variable, which is off by default, and
+ * can be limited to one agent with GOAP.TraceAgent. The same records are sent to Unreal Insights on the GOAP channel (-trace=GOAP).
+ *
+ * GOAP.DumpTrace writes the buffer to a binary file in Saved/GOAPTrace, which can be read back with
+ * UnrealEditor-Cmd AGP.uproject -run=GOAPTraceDump -File=<path> [-Agent=<name>]
+ *
+ * Decisions are only made on the game thread, so the buffer isn't locked.
+ */
+class AGP_API FGOAPTrace
+{
+public:
+	static FGOAPTrace& Get();
+
+	/**
+	 * @return True if records for this agent would be kept, either in the buffer or by Insights.
+	 */
+	static bool IsTracing(FName Agent);
+
+	/**
+	 * Will add a record if the agent is being traced. Does nothing in shipping builds.
+	 */
+	static void Record(EGOAPTraceEvent Event, FName Agent, FName Subject, int32 Value = 0)
+	{
+#if GOAP_TRACE_ENABLED
+		if (IsTracing(Agent))
+		{
+			Get().Add(Event, Agent, Subject, Value);
+		}
+#endif
+	}
+
+	/**
+	 * Will add a FactChanged record for every fact that differs between the two sets.
+	 */
+	static void RecordFactChanges(FName Agent, const FGOAPFactSet& OldFacts, const FGOAPFactSet& NewFacts);
+
+	/**
+	 * @param OutRecords Will be set to the records in the buffer, oldest first.
+	 */
+	void GetRecords(TArray<FGOAPTraceRecord>& OutRecords) const;
+
+	void Clear();
+
+	/**
+	 * Will write the records in the buffer to a file that ReadFile can load.
+	 * @return True if the file was written.
+	 */
+	bool WriteFile(const FString& Filename) const;
+
+	/**
+	 * @param OutRecords Will be set to the records in the file, oldest first.
+	 * @return False if the file couldn't be read or isn't a GOAP trace.
+	 */
+	static bool ReadFile(const FString& Filename, TArray<FGOAPTraceRecord>& OutRecords);
+
+private:
+	FGOAPTrace() = default;
+
+	void Add(EGOAPTraceEvent Event, FName Agent, FName Subject, int32 Value);
+
+	TArray<FGOAPTraceRecord> Records;
+	// Where the next record goes. Once the buffer is full this is also the oldest record.
+	int32 NextRecord = 0;
+	// The GOAP.TraceCapacity the buffer was made for, so it can be cleared when that changes.
+	int32 Capacity = 0;
+};
@@ -23,3 +23,23 @@ int32 UGoal::GetPriority()
 {
 	return Priority;
 }
+
+const FGOAPFactSet& UGoal::GetGoalState() const
+{
+	return GoalState;
+}
+
+const FGOAPFactSet& UGoal::GetRelevanceFacts() const
+{
+	return RelevanceFacts;
+}
+
+const FGOAPFactSet& UGoal::GetUtilityFacts() const
+{
+	return UtilityFacts;
+}
+
+float UGoal::CalculateUtility(const FGOAPFactSet& Facts) const
+{
+	return Priority;
+}
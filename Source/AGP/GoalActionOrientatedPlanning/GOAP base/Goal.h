@@ -18,8 +18,15 @@ class AGP_API UGoal : public UObject
 
 protected:
 	//variableds
-	UPROPERTY(EditAnywhere, Category="GOAP")
-	TMap<FString,bool> GoalState;
+	FGOAPFactSet GoalState;
+
+	// The facts that IsGoalRelevant reads. Only the known bits are used. The agent replans when one of these changes,
+	// so a goal that leaves this empty makes its agent replan whenever any fact changes.
+	FGOAPFactSet RelevanceFacts;
+
+	// The facts CalculateUtility reads. Only the known bits are used. Agents keep the utility they calculated and only
+	// calculate it again when one of these changes, so a goal that leaves this empty is only scored once per agent.
+	FGOAPFactSet UtilityFacts;
 
 	UPROPERTY(EditAnywhere, Category="GOAP")
 	TMap<FString,FVector> GoalStateVectors;
@@ -33,5 +40,17 @@ public:
 	void UpdatePriority(int32 NewPriority);
 	virtual bool IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const;
 	int32 GetPriority();
+	const FGOAPFactSet& GetGoalState() const;
+	const FGOAPFactSet& GetRelevanceFacts() const;
+	const FGOAPFactSet& GetUtilityFacts() const;
+
+	/**
+	 * How much the agent wants to reach the goal. Of the goals the agent can reach, the one whose utility is highest
+	 * once the cost of its plan is taken off is pursued. It must only read the facts in UtilityFacts, as the agent
+	 * keeps the result until one of them changes.
+	 * @param Facts The agent's facts that are in UtilityFacts, with their values. Other facts are unknown.
+	 * @return The priority unless the goal overrides this.
+	 */
+	virtual float CalculateUtility(const FGOAPFactSet& Facts) const;
 	
 };
@@ -2,89 +2,399 @@
 
 
 #include "Planner.h"
-#include "Agent.h"       
-#include "Action.h"      
-#include "Goal.h"        
-#include "WorldState.h"  
-#include "Beliefs.h"     
+#include "Agent.h"
+#include "Action.h"
+#include "Goal.h"
+#include "WorldState.h"
+#include "Beliefs.h"
+#include "GOAPPlanCache.h"
+#include "Algo/Reverse.h"
+#include "Misc/ScopeExit.h"
 
+FGOAPActionData::FGOAPActionData(UAction* InAction, bool bInPossibleNow, float InCost)
+	: Action(InAction)
+	, Preconditions(InAction->GetPreconditions())
+	, Effects(InAction->GetEffects())
+	, Cost(FMath::Max(InCost, 0.0f))
+	, bPossibleNow(bInPossibleNow)
+{
+}
 
 TArray<UAction*> UPlanner::CreatePlan(UAgent* Agent, UGoal* Goal, UWorldState& WorldState,  UBeliefs& Beliefs)
 {
-	TArray<UAction*> AvailableActions = Agent->GetAvailableAction();
+	const FGOAPPlanSnapshot Snapshot = MakeSnapshot(Agent, WorldState, Beliefs);
 	TArray<UAction*> ThePlan;
-	UWorldState* CurrentState = WorldState.Clone();
-	UBeliefs* CurrentBeliefs = Beliefs.Clone();
+	FGOAPPlanStats Stats;
+	SearchPlanCached(Snapshot, Goal->GetGoalState(), *SearchBuffers, ThePlan, Stats);
+	return ThePlan;
+}
+
+TArray<UAction*> UPlanner::FindBestPlan(UAgent* Agent, UWorldState& WorldState, UBeliefs& Beliefs)
+{
+	FGOAPPlanResult Result = ChooseBestPlan(MakeSnapshot(Agent, WorldState, Beliefs), *SearchBuffers);
+	if (Result.Goal)
+	{
+		Agent->CurrentGoal = Result.Goal;
+	}
+	return MoveTemp(Result.Plan);
+}
 
+FGOAPPlanSnapshot UPlanner::MakeSnapshot(UAgent* Agent, const UWorldState& WorldState, UBeliefs& Beliefs) const
+{
+	FGOAPPlanSnapshot Snapshot;
+	Snapshot.Facts = WorldState.GetWorldState();
+	Snapshot.Facts.Apply(Beliefs.GetBeliefsStateConst());
+	Snapshot.MaxPlanDepth = MaxPlanDepth;
+	Snapshot.MaxSearchNodes = MaxSearchNodes;
+	Snapshot.bUsePlanCache = bUsePlanCache;
+	Snapshot.bAllowPartialPlans = bAllowPartialPlans;
+	Snapshot.PlanCostWeight = PlanCostWeight;
 
-	int32 Index = 0;
-	while (Index < AvailableActions.Num())
+	// Context checks that can't be expressed as facts can only be made for the world as it is now, so they only
+	// decide which action the plan can start with.
+	for (UAction* Action : Agent->GetAvailableAction())
+	{
+		const float Cost = FMath::GridSnap(Action->GetCost(WorldState, Beliefs), CostGranularity);
+		const FGOAPActionData& ActionData =
+			Snapshot.Actions.Emplace_GetRef(Action, Action->IsActionPossible(WorldState, Beliefs), Cost);
+		Snapshot.DomainHash = HashCombine(Snapshot.DomainHash, GetTypeHash(Action->GetClass()));
+		Snapshot.DomainHash = HashCombine(Snapshot.DomainHash, GetTypeHash(ActionData.Preconditions));
+		Snapshot.DomainHash = HashCombine(Snapshot.DomainHash, GetTypeHash(ActionData.Effects));
+		Snapshot.DomainHash = HashCombine(Snapshot.DomainHash, GetTypeHash(ActionData.Cost));
+		Snapshot.DomainFacts.AddKnownFacts(ActionData.Preconditions);
+		Snapshot.DomainFacts.AddKnownFacts(ActionData.Effects);
+	}
+
+	// An assigned goal replaces the agent's own goals, apart from the ones that matter more, so the search only has a
+	// small problem to solve.
+	UGoal* AssignedGoal = Agent->GetAssignedGoal();
+	if (AssignedGoal && AssignedGoal->IsGoalRelevant(WorldState, Beliefs))
 	{
-		UAction* Action = AvailableActions[Index];
-		bool bActionPossible = Action->IsActionPossible(*CurrentState, *CurrentBeliefs); 
-        
-		if (bActionPossible)
+		Snapshot.RelevantGoals.Add({ AssignedGoal, AssignedGoal->GetGoalState() });
+		if (Agent->GetAssignedPlanDepth() > 0)
 		{
-			ThePlan.Add(Action);
-			AvailableActions.RemoveAt(Index);
-			Action->ApplyEffects(*CurrentState);
-			if (Goal->IsGoalAchieved(*CurrentState, *CurrentBeliefs))
+			Snapshot.MaxPlanDepth = FMath::Min(Snapshot.MaxPlanDepth, Agent->GetAssignedPlanDepth());
+		}
+	}
+	else
+	{
+		AssignedGoal = nullptr;
+	}
+
+	for (UGoal* Goal : Agent->GetGoals())
+	{
+		if (AssignedGoal && Goal->GetPriority() <= AssignedGoal->GetPriority()) continue;
+		if (Goal->IsGoalRelevant(WorldState, Beliefs))
+		{
+			Snapshot.RelevantGoals.Add({ Goal, Goal->GetGoalState() });
+		}
+	}
+
+	for (FGOAPGoalData& GoalData : Snapshot.RelevantGoals)
+	{
+		GoalData.Utility = Agent->GetGoalUtility(GoalData.Goal, Snapshot.Facts);
+		if (GoalData.Goal == Agent->CurrentGoal)
+		{
+			GoalData.Utility += CurrentGoalBonus;
+		}
+	}
+	Snapshot.RelevantGoals.StableSort([](const FGOAPGoalData& A, const FGOAPGoalData& B)
+	{
+		return A.Utility > B.Utility;
+	});
+	return Snapshot;
+}
+
+FGOAPPlanResult UPlanner::ChooseBestPlan(const FGOAPPlanSnapshot& Snapshot, FGOAPSearchBuffers& Buffers)
+{
+	FGOAPPlanResult Result;
+	float BestScore = 0.0f;
+
+	// The best partial plan, only used if no goal can be reached.
+	FGOAPPlanResult PartialResult;
+	FGOAPPlanStats PartialStats;
+
+	TArray<UAction*> CurrentPlan;
+	for (const FGOAPGoalData& Goal : Snapshot.RelevantGoals)
+	{
+		// The goals are in order of utility and a plan's cost can only take away from it, so once a plan scores at
+		// least this goal's utility none of the goals that are left can beat it.
+		if (Result.Goal && BestScore >= Goal.Utility) break;
+
+		FGOAPPlanStats Stats;
+		const bool bFoundPlan = SearchPlanCached(Snapshot, Goal.GoalState, Buffers, CurrentPlan, Stats);
+		const float PlanCost = Stats.PlanCost;
+
+		if (!bFoundPlan)
+		{
+			const bool bBetterPartialPlan = !PartialResult.Goal ||
+				Stats.UnsatisfiedGoalFacts < PartialStats.UnsatisfiedGoalFacts ||
+				(Stats.UnsatisfiedGoalFacts == PartialStats.UnsatisfiedGoalFacts && PlanCost < PartialStats.PlanCost);
+			if (Stats.bPartialPlan && bBetterPartialPlan)
 			{
-				return ThePlan;
+				PartialResult.Plan = CurrentPlan;
+				PartialResult.Goal = Goal.Goal;
+				PartialStats = Stats;
 			}
 		}
-		else
+		else if (CurrentPlan.Num() > 0)
 		{
-			++Index; // Move to the next action if this action isn't possible
+			const float Score = Goal.Utility - PlanCost * Snapshot.PlanCostWeight;
+			if (!Result.Goal || Score > BestScore)
+			{
+				BestScore = Score;
+				Result.Plan = CurrentPlan;
+				Result.Goal = Goal.Goal;
+			}
 		}
 	}
 
-	if (ThePlan.Num() > 0)
+	if (!Result.Goal && PartialResult.Goal)
+	{
+		Result = MoveTemp(PartialResult);
+		Result.bIsPartial = true;
+	}
+	return Result;
+}
+
+bool UPlanner::SearchPlanCached(const FGOAPPlanSnapshot& Snapshot, const FGOAPFactSet& GoalState,
+	FGOAPSearchBuffers& Buffers, TArray<UAction*>& OutPlan, FGOAPPlanStats& OutStats)
+{
+	if (!Snapshot.bUsePlanCache || Snapshot.Actions.Num() > FGOAPPlanCache::MaxActions)
 	{
-		return ThePlan;
+		return SearchPlan(Snapshot.Facts, GoalState, Snapshot.Actions, Snapshot.MaxPlanDepth, Snapshot.MaxSearchNodes,
+			Buffers, OutPlan, &OutStats, Snapshot.bAllowPartialPlans);
 	}
 
-	// Return an empty plan if no solution is found 
-	return TArray<UAction*>();
+	// Facts that no action or the goal reads or writes never change during the search and can't affect it, so they
+	// are left out of the key. This is what lets agents with unrelated beliefs share a plan.
+	FGOAPFactSet RelevantFacts = Snapshot.DomainFacts;
+	RelevantFacts.AddKnownFacts(GoalState);
+	FGOAPPlanCacheKey Key;
+	Key.DomainHash = Snapshot.DomainHash;
+	Key.NumActions = Snapshot.Actions.Num();
+	Key.GoalState = GoalState;
+	Key.MaxDepth = Snapshot.MaxPlanDepth;
+	Key.MaxNodes = Snapshot.MaxSearchNodes;
+	Key.bAllowPartialPlan = Snapshot.bAllowPartialPlans;
+	for (int32 Word = 0; Word < FGOAPFactSet::NumWords; Word++)
+	{
+		Key.Facts.Known[Word] = Snapshot.Facts.Known[Word] & RelevantFacts.Known[Word];
+		Key.Facts.Values[Word] = Snapshot.Facts.Values[Word] & RelevantFacts.Known[Word];
+	}
+	for (int32 ActionIndex = 0; ActionIndex < Snapshot.Actions.Num(); ActionIndex++)
+	{
+		if (Snapshot.Actions[ActionIndex].bPossibleNow)
+		{
+			Key.PossibleNowMask |= uint64(1) << ActionIndex;
+		}
+	}
+
+	FGOAPCachedPlan CachedPlan;
+	if (FGOAPPlanCache::Get().Find(Key, CachedPlan))
+	{
+		OutPlan.Reset();
+		for (const uint8 ActionIndex : CachedPlan.ActionIndices)
+		{
+			OutPlan.Add(Snapshot.Actions[ActionIndex].Action);
+		}
+		OutStats = FGOAPPlanStats();
+		OutStats.PlanCost = CachedPlan.PlanCost;
+		OutStats.bPartialPlan = CachedPlan.bPartial;
+		OutStats.UnsatisfiedGoalFacts = CachedPlan.UnsatisfiedGoalFacts;
+		return !CachedPlan.bPartial && (OutPlan.Num() > 0 || Snapshot.Facts.Satisfies(GoalState));
+	}
+
+	const bool bFoundPlan = SearchPlan(Snapshot.Facts, GoalState, Snapshot.Actions, Snapshot.MaxPlanDepth,
+		Snapshot.MaxSearchNodes, Buffers, OutPlan, &OutStats, Snapshot.bAllowPartialPlans);
+	CachedPlan.PlanCost = OutStats.PlanCost;
+	CachedPlan.bPartial = OutStats.bPartialPlan;
+	CachedPlan.UnsatisfiedGoalFacts = OutStats.UnsatisfiedGoalFacts;
+	for (const UAction* Action : OutPlan)
+	{
+		CachedPlan.ActionIndices.Add(Snapshot.Actions.IndexOfByPredicate(
+			[Action](const FGOAPActionData& ActionData) { return ActionData.Action == Action; }));
+	}
+	FGOAPPlanCache::Get().Add(Key, CachedPlan);
+	return bFoundPlan;
 }
 
-TArray<UAction*> UPlanner::FindBestPlan(UAgent* Agent, UWorldState& WorldState, UBeliefs& Beliefs)
+bool UPlanner::SearchPlan(const FGOAPFactSet& Start, const FGOAPFactSet& GoalState,
+	TConstArrayView<FGOAPActionData> Actions, int32 MaxDepth, int32 MaxNodes, FGOAPSearchBuffers& Buffers,
+	TArray<UAction*>& OutPlan, FGOAPPlanStats* OutStats, bool bAllowPartialPlan)
 {
-	TArray<UGoal*> Goals = Agent->GetGoals();
-	TArray<UAction*> BestPlan;
-	float BestPlanCost = FLT_MAX;
+	OutPlan.Reset();
+	Buffers.Reset();
+	FGOAPPlanStats Stats;
+	ON_SCOPE_EXIT
+	{
+		if (OutStats)
+		{
+			*OutStats = Stats;
+		}
+	};
+
+	if (Start.Satisfies(GoalState)) return true;
+	Stats.UnsatisfiedGoalFacts = Start.CountUnsatisfied(GoalState);
 
-	for (UGoal* Goal : Goals)
+	// Every unsatisfied goal fact has to be changed by some action, so the cheapest cost per changed fact times the
+	// number of unsatisfied facts is never more than the real cost of reaching the goal.
+	float CostPerFact = UE_MAX_FLT;
+	for (const FGOAPActionData& Action : Actions)
 	{
-		if (!Goal->IsGoalRelevant(WorldState, Beliefs))
+		const int32 NumEffects = Action.Effects.Num();
+		if (NumEffects > 0)
 		{
-			continue;
+			CostPerFact = FMath::Min(CostPerFact, Action.Cost / NumEffects);
 		}
+	}
+	if (CostPerFact == UE_MAX_FLT) return false;
 
-		// Use a planning algorithm like A* here to find the best plan
-		TArray<UAction*> CurrentPlan = CreatePlan(Agent, Goal, WorldState, Beliefs);
+	TArray<FGOAPSearchNode>& Nodes = Buffers.Nodes;
+	TArray<FGOAPOpenEntry>& OpenList = Buffers.OpenList;
+	TMap<FGOAPFactSet, float>& BestGScores = Buffers.BestGScores;
 
-		if (CurrentPlan.Num() > 0)
+	const auto BuildPlan = [&Nodes, &OutPlan, &Stats](int32 LastNodeIndex)
+	{
+		Stats.PlanCost = Nodes[LastNodeIndex].GScore;
+		for (int32 NodeIndex = LastNodeIndex; Nodes[NodeIndex].ParentIndex != INDEX_NONE;
+			NodeIndex = Nodes[NodeIndex].ParentIndex)
 		{
-			float CurrentPlanCost = 0.0f;
-			for (UAction* Action : CurrentPlan)
+			OutPlan.Add(Nodes[NodeIndex].Action);
+		}
+		Algo::Reverse(OutPlan);
+	};
+
+	// The node that leaves the fewest goal facts unsatisfied, and is the cheapest of those, in case the goal can't be
+	// reached. It has to get closer to the goal than the start does.
+	int32 BestPartialNodeIndex = INDEX_NONE;
+	int32 BestPartialUnsatisfied = Stats.UnsatisfiedGoalFacts;
+	const auto BuildPartialPlan = [&]()
+	{
+		if (!bAllowPartialPlan || BestPartialNodeIndex == INDEX_NONE) return;
+		BuildPlan(BestPartialNodeIndex);
+		Stats.bPartialPlan = true;
+		Stats.UnsatisfiedGoalFacts = BestPartialUnsatisfied;
+	};
+
+	FGOAPSearchNode& StartNode = Nodes.AddDefaulted_GetRef();
+	StartNode.State = Start;
+	StartNode.FScore = Start.CountUnsatisfied(GoalState) * CostPerFact;
+	OpenList.HeapPush({ StartNode.FScore, 0 });
+	BestGScores.Add(Start, 0.0f);
+	Stats.NodesGenerated = 1;
+
+	while (!OpenList.IsEmpty())
+	{
+		FGOAPOpenEntry Entry;
+		OpenList.HeapPop(Entry, false);
+		// Copied as adding nodes below can reallocate the array.
+		const FGOAPSearchNode Current = Nodes[Entry.NodeIndex];
+
+		// A cheaper way to this state was found after this entry was added, so it has already been expanded.
+		if (Current.GScore > BestGScores.FindChecked(Current.State)) continue;
+
+		if (Current.State.Satisfies(GoalState))
+		{
+			BuildPlan(Entry.NodeIndex);
+			Stats.UnsatisfiedGoalFacts = 0;
+			return true;
+		}
+
+		if (Current.Depth >= MaxDepth) continue;
+		Stats.NodesExpanded++;
+
+		for (const FGOAPActionData& Action : Actions)
+		{
+			if (Current.Depth == 0 && !Action.bPossibleNow) continue;
+			if (!Current.State.Satisfies(Action.Preconditions)) continue;
+
+			FGOAPFactSet NextState = Current.State;
+			NextState.Apply(Action.Effects);
+			if (NextState == Current.State) continue;
+
+			const float TentativeGScore = Current.GScore + Action.Cost;
+			if (const float* BestGScore = BestGScores.Find(NextState))
 			{
-				CurrentPlanCost += Action->Getcost();
+				if (TentativeGScore >= *BestGScore) continue;
 			}
-			// Check if this goal has a higher priority or if there’s no current goal
-			if (!Agent->CurrentGoal || Goal->GetPriority() > Agent->CurrentGoal->GetPriority())
+
+			if (Nodes.Num() >= MaxNodes)
 			{
-				BestPlan = CurrentPlan;
-				Agent->CurrentGoal = Goal;
-				break; // Higher priority goal found, break the loop
+				Stats.bHitNodeLimit = true;
+				// A node that reaches the goal was generated but not expanded yet. It might not be the cheapest
+				// plan, but it is a complete one.
+				if (BestPartialUnsatisfied == 0)
+				{
+					BuildPlan(BestPartialNodeIndex);
+					Stats.UnsatisfiedGoalFacts = 0;
+					return true;
+				}
+				BuildPartialPlan();
+				return false;
 			}
-			if (CurrentPlanCost < BestPlanCost)
+
+			const int32 NumUnsatisfied = NextState.CountUnsatisfied(GoalState);
+			BestGScores.Add(NextState, TentativeGScore);
+			FGOAPSearchNode& NextNode = Nodes.AddDefaulted_GetRef();
+			NextNode.State = NextState;
+			NextNode.ParentIndex = Entry.NodeIndex;
+			NextNode.Action = Action.Action;
+			NextNode.GScore = TentativeGScore;
+			NextNode.FScore = TentativeGScore + NumUnsatisfied * CostPerFact;
+			NextNode.Depth = Current.Depth + 1;
+			OpenList.HeapPush({ NextNode.FScore, Nodes.Num() - 1 });
+			Stats.NodesGenerated++;
+
+			if (NumUnsatisfied < BestPartialUnsatisfied ||
+				(NumUnsatisfied == BestPartialUnsatisfied && BestPartialNodeIndex != INDEX_NONE &&
+				TentativeGScore < Nodes[BestPartialNodeIndex].GScore))
 			{
-				BestPlanCost = CurrentPlanCost;
-				BestPlan = CurrentPlan;
-				Agent->CurrentGoal = Goal;  
+				BestPartialNodeIndex = Nodes.Num() - 1;
+				BestPartialUnsatisfied = NumUnsatisfied;
 			}
 		}
 	}
-	return BestPlan;
-} 
+	BuildPartialPlan();
+	return false;
+}
+
+bool UPlanner::SearchGreedyPlan(const FGOAPFactSet& Start, const FGOAPFactSet& GoalState,
+	TConstArrayView<FGOAPActionData> Actions, TArray<UAction*>& OutPlan, FGOAPPlanStats* OutStats)
+{
+	OutPlan.Reset();
+	FGOAPPlanStats Stats;
+	FGOAPFactSet CurrentState = Start;
+	TArray<const FGOAPActionData*, TInlineAllocator<16>> AvailableActions;
+	for (const FGOAPActionData& Action : Actions)
+	{
+		AvailableActions.Add(&Action);
+	}
+	bool bReachedGoal = CurrentState.Satisfies(GoalState);
+
+	int32 Index = 0;
+	while (!bReachedGoal && Index < AvailableActions.Num())
+	{
+		const FGOAPActionData* Action = AvailableActions[Index];
+		Stats.NodesExpanded++;
+		if (CurrentState.Satisfies(Action->Preconditions))
+		{
+			OutPlan.Add(Action->Action);
+			Stats.PlanCost += Action->Cost;
+			AvailableActions.RemoveAt(Index);
+			CurrentState.Apply(Action->Effects);
+			Stats.NodesGenerated++;
+			bReachedGoal = CurrentState.Satisfies(GoalState);
+		}
+		else
+		{
+			++Index; // Move to the next action if this action isn't possible
+		}
+	}
+
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+	return bReachedGoal;
+}
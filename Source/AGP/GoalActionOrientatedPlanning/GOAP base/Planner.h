@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Action.h"
 #include "Goal.h"
+#include "GOAPFacts.h"
 #include "UObject/NoExportTypes.h"
 #include "Planner.generated.h"
 
@@ -12,8 +13,140 @@
 class UAgent;
 class UWorldState;
 class UBeliefs;
+
+/**
+ * What a single search did. Used to compare the planners and to tune the search limits.
+ */
+struct FGOAPPlanStats
+{
+	// The number of world states that were taken off the open list and had their actions tried.
+	int32 NodesExpanded = 0;
+	// The number of world states that were added to the open list.
+	int32 NodesGenerated = 0;
+	// True if the search gave up because it ran into the node limit.
+	bool bHitNodeLimit = false;
+	// True if the goal couldn't be reached and the plan returned only gets closer to it.
+	bool bPartialPlan = false;
+	// The number of goal facts that still don't hold at the end of the plan returned.
+	int32 UnsatisfiedGoalFacts = 0;
+	// The total cost of the plan that was returned.
+	float PlanCost = 0.0f;
+};
+
+/**
+ * A copy of what the search needs to know about an action. Actions can change their own facts while they run, so the
+ * search works on a copy rather than reading the action itself.
+ */
+struct FGOAPActionData
+{
+	// Only used to hand the action back in the plan. The search never reads through it.
+	UAction* Action = nullptr;
+	FGOAPFactSet Preconditions;
+	FGOAPFactSet Effects;
+	float Cost = 0.0f;
+	// True if the action's context check passed when the data was copied, so a plan can start with it.
+	bool bPossibleNow = true;
+
+	FGOAPActionData() = default;
+	// InCost is what the action costs the agent now, from UAction::GetCost.
+	FGOAPActionData(UAction* InAction, bool bInPossibleNow, float InCost);
+};
+
 /**
- * 
+ * A copy of a goal that was relevant when the snapshot was taken.
+ */
+struct FGOAPGoalData
+{
+	// Only used to hand the goal back with the plan. The search never reads through it.
+	UGoal* Goal = nullptr;
+	FGOAPFactSet GoalState;
+	// The goal's utility for the agent, including the bonus for the goal it is already pursuing.
+	float Utility = 0.0f;
+};
+
+/**
+ * A plain copy of everything the planner reads from an agent. It is taken on the game thread and is all the search
+ * reads, so the search can run on any thread without touching the agent's UObjects.
+ */
+struct FGOAPPlanSnapshot
+{
+	// The world facts with the agent's own beliefs on top.
+	FGOAPFactSet Facts;
+	TArray<FGOAPActionData, TInlineAllocator<16>> Actions;
+	// The goals whose relevance tests passed, highest utility first.
+	TArray<FGOAPGoalData, TInlineAllocator<8>> RelevantGoals;
+	// How much utility each point of plan cost takes away when the goals are compared.
+	float PlanCostWeight = 0.0f;
+	int32 MaxPlanDepth = 0;
+	int32 MaxSearchNodes = 0;
+	// If true a search that can't reach its goal returns the plan that gets closest to it.
+	bool bAllowPartialPlans = false;
+	// Identifies the agent's set of actions for the plan cache, along with the facts they read or write.
+	bool bUsePlanCache = false;
+	uint32 DomainHash = 0;
+	FGOAPFactSet DomainFacts;
+};
+
+/**
+ * The plan picked for a snapshot, along with the goal it reaches. The goal is null if no relevant goal had a plan.
+ */
+struct FGOAPPlanResult
+{
+	UGoal* Goal = nullptr;
+	TArray<UAction*> Plan;
+	// True if no relevant goal could be reached within the search limits, and the plan only gets closer to the goal.
+	bool bIsPartial = false;
+};
+
+/**
+ * A world state reached during a search. The plan to a node is found by following the parents back to the start node.
+ */
+struct FGOAPSearchNode
+{
+	FGOAPFactSet State;
+	int32 ParentIndex = INDEX_NONE;
+	UAction* Action = nullptr;
+	float GScore = 0.0f;
+	float FScore = 0.0f;
+	int32 Depth = 0;
+};
+
+/**
+ * An entry in the open list. Ties on the FScore are broken by the order the nodes were generated in so the search
+ * always expands the nodes in the same order and returns the same plan.
+ */
+struct FGOAPOpenEntry
+{
+	float FScore;
+	int32 NodeIndex;
+
+	bool operator<(const FGOAPOpenEntry& Other) const
+	{
+		return FScore < Other.FScore || (FScore == Other.FScore && NodeIndex < Other.NodeIndex);
+	}
+};
+
+/**
+ * The containers a search works in. They are reset rather than freed between searches so that a planner which keeps
+ * one of these around stops allocating once it has seen its largest search.
+ */
+struct FGOAPSearchBuffers
+{
+	TArray<FGOAPSearchNode> Nodes;
+	TArray<FGOAPOpenEntry> OpenList;
+	// The lowest GScore found so far for every world state that has been reached.
+	TMap<FGOAPFactSet, float> BestGScores;
+
+	void Reset()
+	{
+		Nodes.Reset();
+		OpenList.Reset();
+		BestGScores.Reset();
+	}
+};
+
+/**
+ *
  */
 UCLASS()
 class AGP_API UPlanner : public UObject
@@ -23,10 +156,117 @@ protected:
 	//variables
 	UPROPERTY(EditAnywhere, Category="GOAP")
 	TArray<UAction*> ActionPool;
-	
+
+	// Plans longer than this are never considered.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	int32 MaxPlanDepth = 8;
+
+	// The search gives up once it has generated this many world states.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	int32 MaxSearchNodes = 1024;
+
+	// If true the results of searches are shared with other agents through the plan cache.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	bool bUsePlanCache = true;
+
+	// If true a search that can't reach its goal within the limits returns the plan that gets closest to it, so the
+	// agent has something to do while it keeps searching over the next frames.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	bool bAllowPartialPlans = true;
+
+	// Every time an agent's plan comes back partial the node limit of its next search is doubled, up to this.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	int32 MaxRefinedSearchNodes = 16384;
+
+	// How much utility each point of plan cost takes away when goals are compared, so a slightly less useful goal with
+	// a much cheaper plan can win.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	float PlanCostWeight = 0.1f;
+
+	// Added to the utility of the goal the agent is already pursuing, so it doesn't flip between two goals whose
+	// scores are close.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	float CurrentGoalBonus = 1.0f;
+
+	// Action costs are rounded to a multiple of this, so that small changes in what they depend on, like a distance,
+	// don't make every search a plan cache miss. 0 keeps the costs as they are.
+	UPROPERTY(EditAnywhere, Category="GOAP")
+	float CostGranularity = 0.5f;
+
+	// Reused by every search this planner runs. Shared so that a search running on a worker thread keeps the buffers
+	// alive even if the planner is destroyed before it finishes.
+	TSharedRef<FGOAPSearchBuffers, ESPMode::ThreadSafe> SearchBuffers =
+		MakeShared<FGOAPSearchBuffers, ESPMode::ThreadSafe>();
+
 public:
 	//functions
 	TArray<UAction*> CreatePlan(UAgent* Agent, UGoal* Goal, UWorldState& WorldState , UBeliefs& Beliefs);
 	TArray<UAction*> FindBestPlan(UAgent* Agent, UWorldState& WorldState, UBeliefs& Beliefs);
-	
+
+	int32 GetMaxPlanDepth() const { return MaxPlanDepth; }
+	int32 GetMaxSearchNodes() const { return MaxSearchNodes; }
+	int32 GetMaxRefinedSearchNodes() const { return FMath::Max(MaxRefinedSearchNodes, MaxSearchNodes); }
+	TSharedRef<FGOAPSearchBuffers, ESPMode::ThreadSafe> GetSearchBuffers() const { return SearchBuffers; }
+
+	/**
+	 * Will copy the facts the agent plans from, its actions and its relevant goals. The context check and the cost of
+	 * every action and the relevance test and utility of every goal are worked out here, so this has to be called on
+	 * the game thread. It is the only part of planning that reads the agent's UObjects.
+	 */
+	FGOAPPlanSnapshot MakeSnapshot(UAgent* Agent, const UWorldState& WorldState, UBeliefs& Beliefs) const;
+
+	/**
+	 * Will plan for the relevant goals in the snapshot and pick the plan whose goal has the highest utility once the
+	 * plan's cost, multiplied by the PlanCostWeight, is taken off. The goals are searched in order of utility and the
+	 * search stops once no goal left could beat the best plan found. If no goal can be reached the partial plan that
+	 * leaves the fewest goal facts unsatisfied is picked, if partial plans are allowed. Only reads the snapshot, so it
+	 * is safe to call from any thread as long as nothing else is using the buffers.
+	 */
+	static FGOAPPlanResult ChooseBestPlan(const FGOAPPlanSnapshot& Snapshot, FGOAPSearchBuffers& Buffers);
+
+	/**
+	 * Will look the search up in the plan cache, and only run it and cache the result if it isn't there.
+	 * @param Snapshot The snapshot whose facts and actions are searched.
+	 * @param GoalState The facts that have to hold at the end of the plan.
+	 * @param Buffers The containers to search in if the search isn't cached.
+	 * @param OutPlan Will be filled with the cheapest plan, using the snapshot's actions.
+	 * @param OutStats Will be set to the stats of the search. Only the cost and whether the plan is partial are set
+	 * if the search was cached.
+	 * @return True if a plan that reaches the goal state was found.
+	 */
+	static bool SearchPlanCached(const FGOAPPlanSnapshot& Snapshot, const FGOAPFactSet& GoalState,
+		FGOAPSearchBuffers& Buffers, TArray<UAction*>& OutPlan, FGOAPPlanStats& OutStats);
+
+	/**
+	 * Will run an A* search forwards from the start state over the world states that the actions can reach. An
+	 * action can be taken whenever its preconditions hold in the state being expanded. The first action also has to
+	 * be possible now, which is whether its context check passed when it was copied. The cost of a plan is
+	 * the sum of its action costs and the heuristic is the number of unsatisfied goal facts multiplied by the lowest
+	 * cost any action pays per fact it changes, so it never overestimates and the cheapest plan is always found.
+	 * @param Start The facts at the start of the plan.
+	 * @param GoalState The facts that have to hold at the end of the plan.
+	 * @param Actions The actions the plan can use.
+	 * @param MaxDepth The maximum number of actions in the plan.
+	 * @param MaxNodes The maximum number of world states to generate before giving up. If a state that reaches the
+	 * goal was already generated by then, the plan to it is returned, even though it might not be the cheapest.
+	 * @param Buffers The containers to search in. Anything in them is thrown away.
+	 * @param OutPlan Will be filled with the cheapest plan, in the order the actions are performed.
+	 * @param OutStats Optional stats about the search.
+	 * @param bAllowPartialPlan If true and the goal can't be reached within the limits, OutPlan is filled with the
+	 * plan to the state found that leaves the fewest goal facts unsatisfied (the cheapest one if there are several),
+	 * as long as that is fewer than at the start.
+	 * @return True if a plan that reaches the goal state was found. An empty plan is returned if the goal already holds.
+	 */
+	static bool SearchPlan(const FGOAPFactSet& Start, const FGOAPFactSet& GoalState,
+		TConstArrayView<FGOAPActionData> Actions, int32 MaxDepth, int32 MaxNodes, FGOAPSearchBuffers& Buffers,
+		TArray<UAction*>& OutPlan, FGOAPPlanStats* OutStats = nullptr, bool bAllowPartialPlan = false);
+
+	/**
+	 * The single pass planner that was used before the A* search. It adds every action whose preconditions hold, in
+	 * array order, until the goal state holds. Only kept so the two planners can be benchmarked against each other.
+	 * @return True if the plan reaches the goal state. The plan is still filled if it doesn't.
+	 */
+	static bool SearchGreedyPlan(const FGOAPFactSet& Start, const FGOAPFactSet& GoalState,
+		TConstArrayView<FGOAPActionData> Actions, TArray<UAction*>& OutPlan, FGOAPPlanStats* OutStats = nullptr);
+
 };
@@ -2,77 +2,80 @@
 
 
 #include "WorldState.h"
+#include "GOAPTrace.h"
 
-UWorldState* UWorldState::Instance = nullptr;
-
-TMap<FString, bool> UWorldState::GetWorldState()
+const FGOAPFactSet& UWorldState::GetWorldState() const
 {
 	return States;
 }
 
-TMap<FString, FVector> UWorldState::GetWorldVectorState()
+TMap<FString, FVector> UWorldState::GetWorldVectorState() const
 {
 	return VectorStates;
 }
 
-TMap<FString, bool> UWorldState::GetWorldState() const 
+bool UWorldState::GetState(FGOAPFactId FactId) const
 {
-	return States;
+	return States.Get(FactId);
 }
 
-TMap<FString, FVector> UWorldState::GetWorldVectorState() const
+bool UWorldState::HasState(FGOAPFactId FactId) const
 {
-	return VectorStates;
+	return States.IsKnown(FactId);
 }
 
-void UWorldState::UpdateState(const TMap<FString, bool>& Effects)
+void UWorldState::UpdateState(const FGOAPFactSet& Effects)
 {
-	for (const TPair<FString, bool>& Effect : Effects)
-	{
-		States.Add(Effect.Key, Effect.Value);
-	}
+	PendingStates.Apply(Effects);
+	bHasPendingWrites = true;
 }
 
 void UWorldState::UpdateVectorState(const TMap<FString, FVector>& Effects)
 {
 	for (const TPair<FString, FVector>& Effect : Effects)
 	{
-		VectorStates.Add(Effect.Key, Effect.Value);
+		PendingVectorStates.Add(Effect.Key, Effect.Value);
 	}
+	bHasPendingWrites |= Effects.Num() > 0;
 }
 
-void UWorldState::SetState(FString key, bool value)
+void UWorldState::SetState(FGOAPFactId FactId, bool value)
 {
-	if(States.Contains(key))
-		States[key] = value;
-	else
-		States.Add(key, value);
+	PendingStates.Set(FactId, value);
+	bHasPendingWrites = true;
 }
 
 void UWorldState::SetVectorState(FString key, FVector value)
 {
-	if(VectorStates.Contains(key))
-		VectorStates[key] = value;
-	else
-		VectorStates.Add(key, value);
+	PendingVectorStates.Add(key, value);
+	bHasPendingWrites = true;
 }
 
-UWorldState* UWorldState::GetInstance()
+bool UWorldState::Publish()
 {
-	if (!Instance)
-	{ 
-		Instance = NewObject<UWorldState>(GetTransientPackage(), UWorldState::StaticClass());
-	}
-	return Instance;
+	if (!bHasPendingWrites) return false;
+	bHasPendingWrites = false;
+
+	if (States == PendingStates && VectorStates.OrderIndependentCompareEqual(PendingVectorStates)) return false;
+	FGOAPTrace::RecordFactChanges(GetFName(), States, PendingStates);
+	States = PendingStates;
+	VectorStates = PendingVectorStates;
+	Version++;
+	return true;
+}
+
+uint32 UWorldState::GetVersion() const
+{
+	return Version;
 }
 
 void UWorldState::PrintWorldStates() const
 {
 	// For boolean states
-	for (auto& worldState : States)
+	States.ForEachKnownFact([](FGOAPFactId FactId, bool bValue)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Key: %s, Value: %s"), *worldState.Key, worldState.Value ? TEXT("True") : TEXT("False"));
-	}
+		UE_LOG(LogTemp, Warning, TEXT("Key: %s, Value: %s"), *FGOAPFactRegistry::Get().GetFactName(FactId).ToString(), bValue ? TEXT("True") : TEXT("False"));
+	});
 
 	// For vector states
 	for (auto& worldState : VectorStates)
@@ -83,26 +86,13 @@ void UWorldState::PrintWorldStates() const
 
 UWorldState::UWorldState()
 {
-	States.Add("Player_One_Dead", false);
-	States.Add("Player_Two_Dead", false);
-	States.Add("AllEnemiesEliminated", false);
-	States.Add("AttackingTarget", false);
-	States.Add("Patrolling", false);
-	States.Add("Dying", false);
+	PendingStates.Set(GOAPFacts::Player_One_Dead, false);
+	PendingStates.Set(GOAPFacts::Player_Two_Dead, false);
+	PendingStates.Set(GOAPFacts::AllEnemiesEliminated, false);
+	PendingStates.Set(GOAPFacts::AttackingTarget, false);
+	PendingStates.Set(GOAPFacts::Patrolling, false);
+	PendingStates.Set(GOAPFacts::Dying, false);
+	States = PendingStates;
 	
 	//PrintWorldStates();
 }
-
-void UWorldState::BeginDestroy()
-{
-	UObject::BeginDestroy();
-	Instance = nullptr;
-}
-
-UWorldState* UWorldState::Clone() 
-{
-	UWorldState* NewWorldState = NewObject<UWorldState>();
-	NewWorldState->States = this->States;  // Assuming States is a TMap or similar
-	NewWorldState->VectorStates = this->VectorStates;  // Deep copy if needed
-	return NewWorldState;
-}
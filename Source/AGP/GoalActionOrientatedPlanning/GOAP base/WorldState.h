@@ -3,11 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GOAPFacts.h"
 #include "UObject/NoExportTypes.h"
 #include "WorldState.generated.h"
 
 /**
- * 
+ * A blackboard shared by the agents of one team. It is double buffered: writes go to a pending copy and readers only
+ * see the facts as they were when the blackboard was last published, which the UGOAPBlackboardSubsystem does once a
+ * frame. Readers always see a stable set of facts however many agents write during the frame, and a snapshot taken
+ * for planning never sees a half written frame. Get one through UGOAPBlackboardSubsystem::GetBlackboard.
  */
 UCLASS()
 class AGP_API UWorldState : public UObject
@@ -16,29 +20,46 @@ class AGP_API UWorldState : public UObject
 
 public:
 	
-	UPROPERTY(VisibleAnywhere, Category = "GOAP")
-	TMap<FString, bool> States;
+	// The facts as of the last publish. These are what every reader sees.
+	FGOAPFactSet States;
 	TMap<FString, FVector> VectorStates;
 
-	TMap<FString, bool> GetWorldState() ;
-	TMap<FString, FVector> GetWorldVectorState() ;
-	TMap<FString, bool> GetWorldState() const ;
+	const FGOAPFactSet& GetWorldState() const;
 	TMap<FString, FVector> GetWorldVectorState() const ;
+
+	/**
+	 * @return The value of the fact as of the last publish, or false if the world doesn't know it.
+	 */
+	bool GetState(FGOAPFactId FactId) const;
+	bool HasState(FGOAPFactId FactId) const;
 	
-	void UpdateState(const TMap<FString, bool>& Effects);
+	// These write to the pending facts, which are seen once the blackboard is next published.
+	void UpdateState(const FGOAPFactSet& Effects);
 	void UpdateVectorState(const TMap<FString, FVector>& Effects);
 	
-	void SetState(FString key, bool value);
+	void SetState(FGOAPFactId FactId, bool value);
 	void SetVectorState(FString key, FVector value);
 
-	static UWorldState* GetInstance();
+	/**
+	 * Will make the pending facts the ones readers see.
+	 * @return True if anything was written since the last publish.
+	 */
+	bool Publish();
+
+	/**
+	 * @return A number that goes up every time a publish changes the facts.
+	 */
+	uint32 GetVersion() const;
 
 	void PrintWorldStates() const;
-	UWorldState* Clone();
 
 protected:
 	UWorldState();
-	virtual void BeginDestroy() override;
-	static UWorldState* Instance;
+
+private:
+	FGOAPFactSet PendingStates;
+	TMap<FString, FVector> PendingVectorStates;
+	bool bHasPendingWrites = false;
+	uint32 Version = 0;
 	
 };
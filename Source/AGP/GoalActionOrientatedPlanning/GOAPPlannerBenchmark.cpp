@@ -0,0 +1,385 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GOAPPlannerBenchmark.h"
+#include "AdvanceAction.h"
+#include "AttackAction.h"
+#include "ChargeAttackAction.h"
+#include "EliminateEnemyGoal.h"
+#include "HealAction.h"
+#include "PatrolAction.h"
+#include "RetreatAction.h"
+#include "StayAliveGoal.h"
+#include "Assignment 3/ChaseThief.h"
+#include "Assignment 3/ChaseThiefAction.h"
+#include "Assignment 3/EvadeDetectionGoal.h"
+#include "Assignment 3/HideAction.h"
+#include "Assignment 3/InvestigateAreaAction.h"
+#include "Assignment 3/InvestigateGoal.h"
+#include "Assignment 3/MoveToWaypointAction.h"
+#include "Assignment 3/PatrolGoal.h"
+#include "Assignment 3/RunAwayAction.h"
+#include "Assignment 3/RunAwayGoal.h"
+#include "Assignment 3/StealAction.h"
+#include "GOAP base/Planner.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	// The optimal plan is only looked for with an exhaustive search while it generates fewer nodes than this.
+	constexpr int32 MaxReferenceNodes = 50000;
+
+	/**
+	 * The actions and goals of one of the agents along with the states its plans start from.
+	 */
+	struct FPlannerBenchmarkDomain
+	{
+		FString Name;
+		TArray<FGOAPActionData> Actions;
+		TArray<FGOAPFactSet> GoalStates;
+		TArray<FGOAPFactSet> StartStates;
+	};
+
+	enum class EBenchmarkPlanner
+	{
+		Greedy,
+		AStar
+	};
+
+	struct FPlannerBenchmarkResult
+	{
+		double Seconds = 0.0;
+		int32 NumPlans = 0;
+		int32 NumReachedGoal = 0;
+		int32 NumHitNodeLimit = 0;
+		float TotalCost = 0.0f;
+		int64 TotalNodesExpanded = 0;
+		// How many searches grew the search buffers or the plan. Allocations that don't grow them aren't counted.
+		int64 NumBufferGrowths = 0;
+		// How many plans were checked against the exhaustive search and how many of those were optimal.
+		int32 NumOptimalityChecked = 0;
+		int32 NumOptimal = 0;
+		// A hash of every plan that was returned, in order. Has to be the same every iteration.
+		uint32 PlansHash = 0;
+		bool bDeterministic = true;
+	};
+
+	/**
+	 * Will make the domain for one of the agents. The class default objects are used so that no agents have to be
+	 * spawned to run the benchmark, and as the benchmark can't run their context checks every action is treated as
+	 * possible. Every combination of the facts is used as a start state.
+	 */
+	FPlannerBenchmarkDomain MakeAgentDomain(const TCHAR* Name, const TArray<UAction*>& Actions,
+		const TArray<UGoal*>& Goals, const TArray<FGOAPFactId>& Facts)
+	{
+		FPlannerBenchmarkDomain Domain;
+		Domain.Name = Name;
+		for (UAction* Action : Actions)
+		{
+			Domain.Actions.Emplace(Action, true, Action->Getcost());
+		}
+		for (const UGoal* Goal : Goals)
+		{
+			Domain.GoalStates.Add(Goal->GetGoalState());
+		}
+		for (uint32 StartIndex = 0; StartIndex < (1u << Facts.Num()); StartIndex++)
+		{
+			FGOAPFactSet& Start = Domain.StartStates.AddDefaulted_GetRef();
+			for (int32 FactIndex = 0; FactIndex < Facts.Num(); FactIndex++)
+			{
+				Start.Set(Facts[FactIndex], (StartIndex & (1u << FactIndex)) != 0);
+			}
+		}
+		return Domain;
+	}
+
+	/**
+	 * Will make a domain that has nothing to do with the game, to see how the planners scale. The first Depth actions
+	 * form a chain where each one sets the fact the next one needs, so the first goal can always be reached. The rest
+	 * of the actions read and write random facts and may or may not give a cheaper way there. The second goal is two
+	 * random facts, which may not be reachable at all.
+	 */
+	FPlannerBenchmarkDomain MakeSyntheticDomain(const FGOAPPlannerBenchmarkSettings& Settings)
+	{
+		const int32 Depth = FMath::Clamp(Settings.Depth, 1, FGOAPFactRegistry::MaxFacts - 1);
+		const int32 NumFacts = FMath::Clamp(Settings.NumFacts, Depth + 1, FGOAPFactRegistry::MaxFacts);
+		const int32 NumActions = FMath::Max(Settings.NumActions, Depth);
+		FRandomStream Random(Settings.Seed);
+
+		FPlannerBenchmarkDomain Domain;
+		Domain.Name = FString::Printf(TEXT("Synthetic (%d facts, %d actions, depth %d)"), NumFacts, NumActions, Depth);
+		for (int32 ActionIndex = 0; ActionIndex < NumActions; ActionIndex++)
+		{
+			// The plans hand back action objects, so every synthetic action needs one of its own.
+			FGOAPActionData& Action = Domain.Actions.AddDefaulted_GetRef();
+			Action.Action = NewObject<UAction>(GetTransientPackage());
+			if (ActionIndex < Depth)
+			{
+				Action.Preconditions.Set(ActionIndex, true);
+				Action.Effects.Set(ActionIndex + 1, true);
+				Action.Cost = Random.RandRange(1, 3);
+				continue;
+			}
+			for (int32 Index = Random.RandRange(1, 2); Index > 0; Index--)
+			{
+				Action.Preconditions.Set(Random.RandRange(0, NumFacts - 1), Random.RandBool());
+			}
+			for (int32 Index = Random.RandRange(1, 2); Index > 0; Index--)
+			{
+				Action.Effects.Set(Random.RandRange(0, NumFacts - 1), Random.RandBool());
+			}
+			Action.Cost = Random.RandRange(1, 5);
+		}
+
+		FGOAPFactSet& ChainGoal = Domain.GoalStates.AddDefaulted_GetRef();
+		ChainGoal.Set(Depth, true);
+		FGOAPFactSet& RandomGoal = Domain.GoalStates.AddDefaulted_GetRef();
+		RandomGoal.Set(Random.RandRange(0, NumFacts - 1), true);
+		RandomGoal.Set(Random.RandRange(0, NumFacts - 1), false);
+
+		for (int32 StartIndex = 0; StartIndex < FMath::Max(Settings.NumStartStates, 1); StartIndex++)
+		{
+			FGOAPFactSet& Start = Domain.StartStates.AddDefaulted_GetRef();
+			for (int32 FactId = 0; FactId < NumFacts; FactId++)
+			{
+				Start.Set(FactId, FactId == 0 || (FactId > Depth && Random.RandBool()));
+			}
+		}
+		return Domain;
+	}
+
+	/**
+	 * Will find the cost of the cheapest plan with an exhaustive uniform cost search. Unlike the A* search the same
+	 * world state reached at different depths is kept apart, so the depth limit can't hide a cheaper plan.
+	 * @param OutCost Will be set to the cost of the cheapest plan, or to UE_MAX_FLT if there is no plan.
+	 * @return False if the search gave up before it was finished.
+	 */
+	bool FindOptimalCost(const FGOAPFactSet& Start, const FGOAPFactSet& GoalState,
+		TConstArrayView<FGOAPActionData> Actions, int32 MaxDepth, float& OutCost)
+	{
+		struct FReferenceNode
+		{
+			FGOAPFactSet State;
+			float Cost;
+			int32 Depth;
+		};
+		TArray<FReferenceNode> Nodes;
+		TArray<FGOAPOpenEntry> OpenList;
+		TMap<TPair<FGOAPFactSet, int32>, float> BestCosts;
+
+		Nodes.Add({ Start, 0.0f, 0 });
+		OpenList.HeapPush({ 0.0f, 0 });
+		OutCost = UE_MAX_FLT;
+		while (!OpenList.IsEmpty())
+		{
+			FGOAPOpenEntry Entry;
+			OpenList.HeapPop(Entry, false);
+			const FReferenceNode Current = Nodes[Entry.NodeIndex];
+			if (Current.State.Satisfies(GoalState))
+			{
+				OutCost = Current.Cost;
+				return true;
+			}
+			if (Current.Depth >= MaxDepth) continue;
+
+			for (const FGOAPActionData& Action : Actions)
+			{
+				if (Current.Depth == 0 && !Action.bPossibleNow) continue;
+				if (!Current.State.Satisfies(Action.Preconditions)) continue;
+				FGOAPFactSet NextState = Current.State;
+				NextState.Apply(Action.Effects);
+				if (NextState == Current.State) continue;
+
+				const float NextCost = Current.Cost + Action.Cost;
+				const TPair<FGOAPFactSet, int32> Key(NextState, Current.Depth + 1);
+				if (const float* BestCost = BestCosts.Find(Key))
+				{
+					if (NextCost >= *BestCost) continue;
+				}
+				if (Nodes.Num() >= MaxReferenceNodes) return false;
+				BestCosts.Add(Key, NextCost);
+				Nodes.Add({ NextState, NextCost, Current.Depth + 1 });
+				OpenList.HeapPush({ NextCost, Nodes.Num() - 1 });
+			}
+		}
+		return true;
+	}
+
+	SIZE_T GetAllocatedSize(const FGOAPSearchBuffers& SearchBuffers, const TArray<UAction*>& Plan)
+	{
+		return SearchBuffers.Nodes.GetAllocatedSize() + SearchBuffers.OpenList.GetAllocatedSize() +
+			SearchBuffers.BestGScores.GetAllocatedSize() + Plan.GetAllocatedSize();
+	}
+
+	/**
+	 * Will plan for every goal of the domain from every start state, Iterations times over.
+	 */
+	FPlannerBenchmarkResult RunPlannerBenchmark(const FPlannerBenchmarkDomain& Domain, EBenchmarkPlanner Planner,
+		int32 Iterations)
+	{
+		const UPlanner* DefaultPlanner = GetDefault<UPlanner>();
+		const int32 MaxDepth = DefaultPlanner->GetMaxPlanDepth();
+		const int32 MaxNodes = DefaultPlanner->GetMaxSearchNodes();
+
+		TMap<const UAction*, int32> ActionIndices;
+		for (int32 ActionIndex = 0; ActionIndex < Domain.Actions.Num(); ActionIndex++)
+		{
+			ActionIndices.Add(Domain.Actions[ActionIndex].Action, ActionIndex);
+		}
+
+		FPlannerBenchmarkResult Result;
+		FGOAPSearchBuffers SearchBuffers;
+		TArray<UAction*> Plan;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			uint32 PlansHash = 0;
+			for (const FGOAPFactSet& Start : Domain.StartStates)
+			{
+				for (const FGOAPFactSet& GoalState : Domain.GoalStates)
+				{
+					// Counts the searches that grew a buffer. The buffers are kept between searches, so once they fit the
+					// largest search this should stay at zero.
+					const SIZE_T AllocatedSize = GetAllocatedSize(SearchBuffers, Plan);
+
+					FGOAPPlanStats Stats;
+					const bool bReachedGoal = Planner == EBenchmarkPlanner::Greedy
+						? UPlanner::SearchGreedyPlan(Start, GoalState, Domain.Actions, Plan, &Stats)
+						: UPlanner::SearchPlan(Start, GoalState, Domain.Actions, MaxDepth, MaxNodes, SearchBuffers,
+							Plan, &Stats);
+
+					PlansHash = HashCombine(PlansHash, GetTypeHash(bReachedGoal));
+					PlansHash = HashCombine(PlansHash, GetTypeHash(Stats.PlanCost));
+					for (const UAction* Action : Plan)
+					{
+						PlansHash = HashCombine(PlansHash, GetTypeHash(ActionIndices.FindChecked(Action)));
+					}
+
+					// Only the first iteration is counted so the totals don't depend on the number of iterations.
+					if (Iteration > 0) continue;
+					Result.NumBufferGrowths += GetAllocatedSize(SearchBuffers, Plan) > AllocatedSize ? 1 : 0;
+					Result.NumPlans++;
+					Result.NumReachedGoal += bReachedGoal ? 1 : 0;
+					Result.NumHitNodeLimit += Stats.bHitNodeLimit ? 1 : 0;
+					Result.TotalCost += bReachedGoal ? Stats.PlanCost : 0.0f;
+					Result.TotalNodesExpanded += Stats.NodesExpanded;
+				}
+			}
+
+			if (Iteration == 0)
+			{
+				Result.PlansHash = PlansHash;
+			}
+			else if (PlansHash != Result.PlansHash)
+			{
+				Result.bDeterministic = false;
+			}
+		}
+		Result.Seconds = FPlatformTime::Seconds() - StartTime;
+
+		// Checked outside the timed loop, as the exhaustive search is far slower than the planners.
+		for (const FGOAPFactSet& Start : Domain.StartStates)
+		{
+			for (const FGOAPFactSet& GoalState : Domain.GoalStates)
+			{
+				float OptimalCost;
+				if (!FindOptimalCost(Start, GoalState, Domain.Actions, MaxDepth, OptimalCost)) continue;
+
+				FGOAPPlanStats Stats;
+				const bool bReachedGoal = Planner == EBenchmarkPlanner::Greedy
+					? UPlanner::SearchGreedyPlan(Start, GoalState, Domain.Actions, Plan, &Stats)
+					: UPlanner::SearchPlan(Start, GoalState, Domain.Actions, MaxDepth, MaxNodes, SearchBuffers, Plan,
+						&Stats);
+				Result.NumOptimalityChecked++;
+				const bool bPlanExists = OptimalCost != UE_MAX_FLT;
+				if (bReachedGoal == bPlanExists && (!bPlanExists || FMath::IsNearlyEqual(Stats.PlanCost, OptimalCost)))
+				{
+					Result.NumOptimal++;
+				}
+			}
+		}
+		return Result;
+	}
+
+	void LogPlannerBenchmarkResult(const FString& DomainName, const TCHAR* PlannerName, int32 Iterations,
+		const FPlannerBenchmarkResult& Result)
+	{
+		const int32 NumPlans = FMath::Max(Result.NumPlans, 1);
+		UE_LOG(LogTemp, Display,
+			TEXT("%s %s: %.0f plans per second, reached the goal in %d/%d plans (%d hit the node limit), average cost ")
+			TEXT("%.2f, average nodes expanded %.2f, %.3f buffer growths per plan, optimal in %d/%d checked plans, ")
+			TEXT("plans hash %08x%s"),
+			*DomainName, PlannerName, NumPlans * Iterations / FMath::Max(Result.Seconds, UE_SMALL_NUMBER),
+			Result.NumReachedGoal, Result.NumPlans, Result.NumHitNodeLimit,
+			Result.TotalCost / FMath::Max(Result.NumReachedGoal, 1),
+			static_cast<double>(Result.TotalNodesExpanded) / NumPlans,
+			static_cast<double>(Result.NumBufferGrowths) / NumPlans, Result.NumOptimal, Result.NumOptimalityChecked,
+			Result.PlansHash, Result.bDeterministic ? TEXT("") : TEXT(", NOT DETERMINISTIC"))
+	}
+
+	void RunPlannerBenchmarksCommand(const TArray<FString>& Args)
+	{
+		FGOAPPlannerBenchmarkSettings Settings;
+		Settings.ParseCommandLine(*FString::Join(Args, TEXT(" ")));
+		RunGOAPPlannerBenchmarks(Settings);
+	}
+
+	FAutoConsoleCommand PlannerBenchmarkCommand(
+		TEXT("GOAP.BenchmarkPlanners"),
+		TEXT("Plans every goal of every agent and of a synthetic domain with the greedy planner and the A* planner and ")
+		TEXT("logs how fast and how good their plans were. Takes the same -Iterations=, -Facts=, -Actions=, -Depth=, ")
+		TEXT("-StartStates= and -Seed= arguments as the GOAPPlannerBenchmark commandlet."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunPlannerBenchmarksCommand));
+}
+
+void FGOAPPlannerBenchmarkSettings::ParseCommandLine(const TCHAR* CommandLine)
+{
+	FParse::Value(CommandLine, TEXT("Iterations="), Iterations);
+	FParse::Value(CommandLine, TEXT("Facts="), NumFacts);
+	FParse::Value(CommandLine, TEXT("Actions="), NumActions);
+	FParse::Value(CommandLine, TEXT("Depth="), Depth);
+	FParse::Value(CommandLine, TEXT("StartStates="), NumStartStates);
+	FParse::Value(CommandLine, TEXT("Seed="), Seed);
+	Iterations = FMath::Max(Iterations, 1);
+}
+
+bool RunGOAPPlannerBenchmarks(const FGOAPPlannerBenchmarkSettings& Settings)
+{
+	TArray<FPlannerBenchmarkDomain> Domains;
+	Domains.Add(MakeAgentDomain(TEXT("Enemy"),
+		{ GetMutableDefault<UChargeAttackAction>(), GetMutableDefault<UAttackAction>(),
+			GetMutableDefault<UAdvanceAction>(), GetMutableDefault<UPatrolAction>(), GetMutableDefault<UHealAction>(),
+			GetMutableDefault<URetreatAction>() },
+		{ GetMutableDefault<UEliminateEnemyGoal>(), GetMutableDefault<UStayAliveGoal>() },
+		{ GOAPFacts::TargetSpotted, GOAPFacts::InDangerOfDeath, GOAPFacts::HasFullHealth, GOAPFacts::WithinRange,
+			GOAPFacts::SafeDistanceToHeal, GOAPFacts::AttackingTarget }));
+	Domains.Add(MakeAgentDomain(TEXT("Patrol"),
+		{ GetMutableDefault<UInvestigateAreaAction>(), GetMutableDefault<UMoveToWaypointAction>(),
+			GetMutableDefault<UChaseThiefAction>() },
+		{ GetMutableDefault<UInvestigateGoal>(), GetMutableDefault<UChaseThief>(), GetMutableDefault<UPatrolGoal>() },
+		{ GOAPFacts::ThiefVisible, GOAPFacts::ThiefLastKnownLocation, GOAPFacts::AtWaypoint }));
+	Domains.Add(MakeAgentDomain(TEXT("Thief"),
+		{ GetMutableDefault<UStealAction>(), GetMutableDefault<UHideAction>(), GetMutableDefault<URunAwayAction>() },
+		{ GetMutableDefault<UEvadeDetectionGoal>(), GetMutableDefault<URunAwayGoal>() },
+		{ GOAPFacts::ThiefVisible, GOAPFacts::GoldTaken, GOAPFacts::Escaped }));
+	Domains.Add(MakeSyntheticDomain(Settings));
+
+	bool bDeterministic = true;
+	for (const FPlannerBenchmarkDomain& Domain : Domains)
+	{
+		const FPlannerBenchmarkResult GreedyResult =
+			RunPlannerBenchmark(Domain, EBenchmarkPlanner::Greedy, Settings.Iterations);
+		const FPlannerBenchmarkResult SearchResult =
+			RunPlannerBenchmark(Domain, EBenchmarkPlanner::AStar, Settings.Iterations);
+		LogPlannerBenchmarkResult(Domain.Name, TEXT("greedy"), Settings.Iterations, GreedyResult);
+		LogPlannerBenchmarkResult(Domain.Name, TEXT("A*"), Settings.Iterations, SearchResult);
+		bDeterministic &= GreedyResult.bDeterministic && SearchResult.bDeterministic;
+	}
+
+	if (!bDeterministic)
+	{
+		UE_LOG(LogTemp, Error, TEXT("GOAP planner benchmark: a search returned a different plan between iterations."))
+	}
+	return bDeterministic;
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * What the planner benchmark runs. The synthetic domain is generated from the seed, so the same settings always
+ * produce the same domain and the same plans.
+ */
+struct FGOAPPlannerBenchmarkSettings
+{
+	// How many times every search is repeated. Only used for the timings.
+	int32 Iterations = 100;
+	// The size of the synthetic domain.
+	int32 NumFacts = 32;
+	int32 NumActions = 24;
+	// The length of the chain of actions that the synthetic goal can always be reached through.
+	int32 Depth = 6;
+	int32 NumStartStates = 64;
+	int32 Seed = 1;
+
+	/**
+	 * Will read any of -Iterations=, -Facts=, -Actions=, -Depth=, -StartStates= and -Seed= from the command line.
+	 */
+	void ParseCommandLine(const TCHAR* CommandLine);
+};
+
+/**
+ * Will plan every goal of the enemy, patrol and thief domains from every combination of their facts, and every goal
+ * of a synthetic domain from random start states, with both the greedy planner and the A* planner. Logs the plans per
+ * second, nodes expanded, search buffer growths per plan and how many of the plans were optimal for each. Every search
+ * is repeated for each iteration and its plan has to be identical every time.
+ * Only uses class default objects and plain data, so it doesn't need a world and can be run from a commandlet.
+ * @return True if every search returned the same plan in every iteration.
+ */
+AGP_API bool RunGOAPPlannerBenchmarks(const FGOAPPlannerBenchmarkSettings& Settings);
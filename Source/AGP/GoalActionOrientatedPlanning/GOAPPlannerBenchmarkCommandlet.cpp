@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPPlannerBenchmarkCommandlet.h"
+#include "GOAPPlannerBenchmark.h"
+
+UGOAPPlannerBenchmarkCommandlet::UGOAPPlannerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGOAPPlannerBenchmarkCommandlet::Main(const FString& Params)
+{
+	FGOAPPlannerBenchmarkSettings Settings;
+	Settings.ParseCommandLine(*Params);
+	return RunGOAPPlannerBenchmarks(Settings) ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GOAPPlannerBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs the GOAP planner benchmark headless, with no world and no rendering:
+ * UnrealEditor-Cmd AGP.uproject -run=GOAPPlannerBenchmark [-Iterations=N -Facts=N -Actions=N -Depth=N -Seed=N]
+ * Returns a non zero exit code if any search didn't return the same plan every time it was run.
+ */
+UCLASS()
+class AGP_API UGOAPPlannerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UGOAPPlannerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
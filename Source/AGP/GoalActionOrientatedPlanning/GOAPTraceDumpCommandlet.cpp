@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GOAPTraceDumpCommandlet.h"
+#include "GOAP base/GOAPTrace.h"
+
+UGOAPTraceDumpCommandlet::UGOAPTraceDumpCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGOAPTraceDumpCommandlet::Main(const FString& Params)
+{
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("File="), Filename))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=GOAPTraceDump -File=<path> [-Agent=<name>]"))
+		return 1;
+	}
+
+	TArray<FGOAPTraceRecord> Records;
+	if (!FGOAPTrace::ReadFile(Filename, Records))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a GOAP trace or couldn't be read"), *Filename)
+		return 1;
+	}
+
+	FString Agent;
+	FParse::Value(*Params, TEXT("Agent="), Agent);
+	const FName AgentFilter = Agent.IsEmpty() ? NAME_None : FName(*Agent);
+
+	const double StartTime = Records.Num() > 0 ? Records[0].Time : 0.0;
+	int32 NumPrinted = 0;
+	for (const FGOAPTraceRecord& Record : Records)
+	{
+		if (!AgentFilter.IsNone() && Record.Agent != AgentFilter) continue;
+		UE_LOG(LogTemp, Display, TEXT("%s"), *Record.ToString(StartTime))
+		NumPrinted++;
+	}
+	UE_LOG(LogTemp, Display, TEXT("%d of %d GOAP trace records printed"), NumPrinted, Records.Num())
+	return 0;
+}
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GOAPTraceDumpCommandlet.generated.h"
+
+/**
+ * Prints a GOAP trace written by GOAP.DumpTrace as text, optionally only the records of one agent:
+ * UnrealEditor-Cmd AGP.uproject -run=GOAPTraceDump -File=<path> [-Agent=<name>]
+ * Returns a non zero exit code if the file couldn't be read.
+ */
+UCLASS()
+class AGP_API UGOAPTraceDumpCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UGOAPTraceDumpCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
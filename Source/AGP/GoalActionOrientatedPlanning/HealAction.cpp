@@ -8,51 +8,54 @@
 #include "AGP/Characters/HealthComponent.h"
 
 
+namespace
+{
+	constexpr FGOAPActionDescriptor HealActionDescriptor = FGOAPActionDescriptor(4.0f)
+		.Requires(GOAPFacts::TargetSpotted, false)
+		.Requires(GOAPFacts::InDangerOfDeath, true)
+		.Requires(GOAPFacts::HasFullHealth, false)
+		.Requires(GOAPFacts::SafeDistanceToHeal, true)
+		.Causes(GOAPFacts::InDangerOfDeath, false)
+		.Causes(GOAPFacts::HasFullHealth, true);
+}
+
 UHealAction::UHealAction()
 {
-	cost = 4.0f;
-	Preconditions.Add("TargetSpotted", false);
-	Preconditions.Add("InDangerOfDeath", true);
-	Preconditions.Add("HasFullHealth", false);
-	Preconditions.Add("SafeDistanceToHeal", true);
-	Effects.Add("InDangerOfDeath", false);
-	Effects.Add("HasFullHealth", true);
+	SetDescriptor(HealActionDescriptor);
 }
 
-bool UHealAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool UHealAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	const bool bOutOfHarmToHeal =  EnemyAgent->GetBeliefs()->GetBeliefsState()["SafeDistanceToHeal"] == true;
-	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] == true;
-	const bool bHasFullHealth = EnemyAgent->GetBeliefs()->GetBeliefsState()["HasFullHealth"] == false;
-	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"] == false;
+	const bool bOutOfHarmToHeal =  Beliefs.GetBelief(GOAPFacts::SafeDistanceToHeal) == true;
+	const bool bInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == true;
+	const bool bHasFullHealth = Beliefs.GetBelief(GOAPFacts::HasFullHealth) == false;
+	const bool bTargetSpotted = Beliefs.GetBelief(GOAPFacts::TargetSpotted) == false;
 
 	return bOutOfHarmToHeal && bInDangerOfDeath && bHasFullHealth && bTargetSpotted;
 	
 }
 
-void UHealAction::PerformAction()
+void UHealAction::PerformAction(FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
 	UHealthComponent* EnemyAgentHealthComponent = EnemyAgent->GetHealthComponent();
 	EnemyAgentHealthComponent->ApplyHealing(0.5f);
-	UE_LOG(LogTemp, Warning, TEXT("Agent healing itself for: %f"), 0.01f); 
-	UE_LOG(LogTemp, Warning, TEXT("Agent's health is : %f"),EnemyAgentHealthComponent->GetCurrentHealth()); 
+	UE_LOG(LogTemp, Verbose, TEXT("Agent's health is : %f"),EnemyAgentHealthComponent->GetCurrentHealth()); 
 }
 
-bool UHealAction::IsActionComplete() const
+bool UHealAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	const bool bNoLongerSafeToHeal = EnemyAgent->GetBeliefs()->GetBeliefsState()["SafeDistanceToHeal"] == false;
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	const bool bNoLongerSafeToHeal = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::SafeDistanceToHeal) == false;
 	const bool bFullyHealed = EnemyAgent->GetHealthComponent()->GetCurrentHealthPercentage() >= 1.0f;
 	return bFullyHealed || bNoLongerSafeToHeal;
 }
 
-void UHealAction::ApplyEffects(UWorldState& WorldState)
+void UHealAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] = false;
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["HasFullHealth"] = true;
-	Super::ApplyEffects(WorldState);
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::InDangerOfDeath, false);
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::HasFullHealth, true);
+	Super::ApplyEffects(Context, WorldState);
 }
 
@@ -14,16 +14,16 @@ class AGP_API UHealAction : public UAction
 {
 	GENERATED_BODY()
 	UHealAction();
-	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)override;
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
 
 	// Chase the thief (move towards the last known location)
-	virtual void PerformAction() override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
 
 	// Check if the action is complete (e.g., lost sight of thief)
-	virtual bool IsActionComplete() const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
 
 	// Apply effects to the world state (e.g., thief is no longer visible after chase)
-	virtual void ApplyEffects(UWorldState& WorldState) override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 	
 	
 };
@@ -5,40 +5,47 @@
 #include "AGP/Characters/EnemyCharacter.h"
 #include "EnemyAgentBeliefs.h"
 
-UPatrolAction::UPatrolAction()
+namespace
 {
-	cost = 15.0f;
-	//kinda like a default state
+	constexpr FGOAPActionDescriptor PatrolActionDescriptor = FGOAPActionDescriptor(15.0f)
+		//kinda like a default state
+		.Requires(GOAPFacts::TargetSpotted, false)
+		.Requires(GOAPFacts::InDangerOfDeath, false)
+		// Patrolling only finishes once a target has been found
+		.Causes(GOAPFacts::TargetSpotted, true)
+		.Causes(GOAPFacts::WithinRange, true);
 }
 
-bool UPatrolAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+UPatrolAction::UPatrolAction()
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
+	SetDescriptor(PatrolActionDescriptor);
+}
 
-	const bool bNoTargetSpotted = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"] == false;
-	const bool bNotInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] == false;
+bool UPatrolAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const bool bNoTargetSpotted = Beliefs.GetBelief(GOAPFacts::TargetSpotted) == false;
+	const bool bNotInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == false;
 
 	return bNoTargetSpotted && bNotInDangerOfDeath;
 }
 
-void UPatrolAction::PerformAction()
+void UPatrolAction::PerformAction(FGOAPActionContext& Context) const
 {
-	if(AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(GetOuter()->GetOuter()))
+	if(AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Patrolling...")); 
 		EnemyCharacter->TickPatrol();
 	}
 }
 
-bool UPatrolAction::IsActionComplete() const
+bool UPatrolAction::IsActionComplete(const FGOAPActionContext& Context) const
 { 
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"];
-	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"];
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent); 
+	const bool bTargetSpotted = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::TargetSpotted);
+	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::InDangerOfDeath);
 	return bTargetSpotted || bInDangerOfDeath; 
 }
 
-void UPatrolAction::ApplyEffects(UWorldState& WorldState)
+void UPatrolAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
+	Super::ApplyEffects(Context, WorldState);
 }
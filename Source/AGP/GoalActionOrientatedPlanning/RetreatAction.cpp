@@ -5,44 +5,48 @@
 #include "EnemyAgentBeliefs.h"
 #include "AGP/Characters/EnemyCharacter.h"
 
+namespace
+{
+	constexpr FGOAPActionDescriptor RetreatActionDescriptor = FGOAPActionDescriptor(1.0f)
+		.Requires(GOAPFacts::InDangerOfDeath, true)
+		// Retreating only gets the agent far enough away to heal, it is still in danger until it has healed
+		.Causes(GOAPFacts::TargetSpotted, false)
+		.Causes(GOAPFacts::SafeDistanceToHeal, true)
+		.Causes(GOAPFacts::AttackingTarget, false);
+}
+
 URetreatAction::URetreatAction()
 {
-	cost = 1.0f;
-	Preconditions.Add("InDangerOfDeath", true);
-	Effects.Add("InDangerOfDeath", false);
-	Effects.Add("TargetSpotted", false);
-	Effects.Add("SafeDistanceToHeal", true);
-	Effects.Add("AttackingTarget", false);
+	SetDescriptor(RetreatActionDescriptor);
 }
 
-bool URetreatAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)
+bool URetreatAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"];
+	const bool bInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath);
 	return bInDangerOfDeath;
 }
 
-void URetreatAction::PerformAction()
+void URetreatAction::PerformAction(FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
 	if(AEnemyCharacter* EnemyCharacter = EnemyAgent->GetEnemyCharacterComponent())
 	{
-		EnemyAgent->GetBeliefs()->GetBeliefsState()["SafeDistanceToHeal"] = false;
+		EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::SafeDistanceToHeal, false);
 		EnemyCharacter->TickEvade();
 	}
 }
 
-bool URetreatAction::IsActionComplete() const
+bool URetreatAction::IsActionComplete(const FGOAPActionContext& Context) const
 {
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter());
-	return EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"];
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	return EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::TargetSpotted);
 }
 
-void URetreatAction::ApplyEffects(UWorldState& WorldState)
+void URetreatAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
 {
-	Super::ApplyEffects(WorldState);
-	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(GetOuter()); 
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["InDangerOfDeath"] = false;
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["TargetSpotted"] = false;
-	EnemyAgent->GetBeliefs()->GetBeliefsState()["SafeDistanceToHeal"] = true;
+	Super::ApplyEffects(Context, WorldState);
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent); 
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::InDangerOfDeath, false);
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::TargetSpotted, false);
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::SafeDistanceToHeal, true);
 }
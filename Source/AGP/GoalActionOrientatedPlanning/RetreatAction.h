@@ -14,8 +14,8 @@ class AGP_API URetreatAction : public UAction
 {
 	GENERATED_BODY()
 	URetreatAction();
-	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs)override;
-	virtual void PerformAction() override;
-	virtual bool IsActionComplete() const override;
-	virtual void ApplyEffects(UWorldState& WorldState) override;
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 };
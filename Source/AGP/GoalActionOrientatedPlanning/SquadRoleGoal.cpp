@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AGP/GoalActionOrientatedPlanning/SquadRoleGoal.h"
+
+
+USquadRoleGoal::USquadRoleGoal()
+{
+	// Above eliminating enemies, which the roles are a way of doing, and below staying alive
+	Priority = 12;
+	RelevanceFacts.Set(GOAPFacts::InDangerOfDeath, true);
+	SetRole(ESquadRole::Advance);
+}
+
+void USquadRoleGoal::SetRole(ESquadRole NewRole)
+{
+	Role = NewRole;
+	GoalState = FGOAPFactSet();
+	switch (Role)
+	{
+	case ESquadRole::Suppress:
+		GoalState.Set(GOAPFacts::SuppressingTarget, true);
+		break;
+	case ESquadRole::Flank:
+		// Flanking on its own doesn't finish the role, the flanker attacks once it is round the side
+		GoalState.Set(GOAPFacts::FlankingTarget, true);
+		GoalState.Set(GOAPFacts::AttackingTarget, true);
+		break;
+	case ESquadRole::Advance:
+		GoalState.Set(GOAPFacts::AttackingTarget, true);
+		break;
+	}
+}
+
+ESquadRole USquadRoleGoal::GetRole() const
+{
+	return Role;
+}
+
+bool USquadRoleGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	FGOAPFactSet Facts = WorldState.GetWorldState();
+	Facts.Apply(Beliefs.GetBeliefsStateConst());
+	return Facts.Satisfies(GoalState);
+}
+
+bool USquadRoleGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
+{
+	return !Beliefs.GetBelief(GOAPFacts::InDangerOfDeath);
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GOAP base/Goal.h"
+#include "SquadRoleGoal.generated.h"
+
+/**
+ * The parts an enemy can play in its squad's plan.
+ */
+UENUM()
+enum class ESquadRole : uint8
+{
+	// Hold back in cover and keep firing at where the target was last seen.
+	Suppress,
+	// Move round to the side of the target, then attack it from there.
+	Flank,
+	// Go straight for the target.
+	Advance,
+};
+
+/**
+ * The goal an enemy squad hands to a member for its role. Every squad keeps one of these per role and shares it
+ * between the members with that role. It isn't relevant while the member is in danger of death, so staying alive
+ * always comes first.
+ */
+UCLASS()
+class AGP_API USquadRoleGoal : public UGoal
+{
+	GENERATED_BODY()
+	USquadRoleGoal();
+
+public:
+	/**
+	 * Will set the goal state and priority for the role. Has to be called before the goal is handed to a member.
+	 */
+	void SetRole(ESquadRole NewRole);
+	ESquadRole GetRole() const;
+
+	virtual bool IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual bool IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const override;
+
+private:
+	ESquadRole Role = ESquadRole::Advance;
+};
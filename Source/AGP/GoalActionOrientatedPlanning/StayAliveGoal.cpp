@@ -9,16 +9,24 @@ class UEnemyAgentBeliefs;
 
 UStayAliveGoal::UStayAliveGoal()
 {
-	GoalState.Add("InDangerOfDeath", false);
+	GoalState.Set(GOAPFacts::InDangerOfDeath, false);
 	Priority = 15;
+	RelevanceFacts.Set(GOAPFacts::InDangerOfDeath, true);
+	UtilityFacts.Set(GOAPFacts::TargetSpotted, true);
 }
 
 bool UStayAliveGoal::IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const
 {
-	return Beliefs.GetBeliefsStateConst()["InDangerOfDeath"] == false;
+	return Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == false;
 }
 
 bool UStayAliveGoal::IsGoalRelevant(const UWorldState& WorldState, UBeliefs& Beliefs) const
 {
-	return Beliefs.GetBeliefsState()["InDangerOfDeath"] == true;
+	return Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == true;
+}
+
+float UStayAliveGoal::CalculateUtility(const FGOAPFactSet& Facts) const
+{
+	// Being in danger matters even more while the target can see the enemy
+	return Facts.Get(GOAPFacts::TargetSpotted) ? Priority + 2.0f : Priority;
 }
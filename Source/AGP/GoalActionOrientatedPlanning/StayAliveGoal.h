@@ -16,5 +16,6 @@ class AGP_API UStayAliveGoal : public UGoal
 	UStayAliveGoal();
 	virtual bool IsGoalAchieved(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
 	virtual bool IsGoalRelevant(const UWorldState& WorldState,  UBeliefs& Beliefs) const;
+	virtual float CalculateUtility(const FGOAPFactSet& Facts) const override;
 	
 };
@@ -1,3 +1,60 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AGP/GoalActionOrientatedPlanning/SuppressPlayerAction.h"
 
+#include "EnemyAgent.h"
+#include "EnemyAgentBeliefs.h"
+#include "AGP/Characters/EnemyCharacter.h"
+
+namespace
+{
+	constexpr FGOAPActionDescriptor SuppressPlayerActionDescriptor = FGOAPActionDescriptor(2.0f)
+		.Requires(GOAPFacts::InCover, true)
+		.Requires(GOAPFacts::InDangerOfDeath, false)
+		.Causes(GOAPFacts::SuppressingTarget, true);
+}
+
+USuppressPlayerAction::USuppressPlayerAction()
+{
+	SetDescriptor(SuppressPlayerActionDescriptor);
+}
+
+bool USuppressPlayerAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const bool bInCover = Beliefs.GetBelief(GOAPFacts::InCover);
+	const bool bNotInDangerOfDeath = Beliefs.GetBelief(GOAPFacts::InDangerOfDeath) == false;
+	const bool bLastKnownPosition =
+		Beliefs.GetBeliefsStateVectorsConst().FindRef("LastKnownTargetPosition") != FVector::ZeroVector;
+	return bInCover && bNotInDangerOfDeath && bLastKnownPosition;
+}
+
+void USuppressPlayerAction::PerformAction(FGOAPActionContext& Context) const
+{
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
+	// Set while firing so the squad knows the target is pinned down
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::SuppressingTarget, true);
+	EnemyCharacter->TickSuppress(EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("LastKnownTargetPosition"));
+}
+
+bool USuppressPlayerAction::IsActionComplete(const FGOAPActionContext& Context) const
+{
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	const bool bNoTarget =
+		EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("LastKnownTargetPosition") == FVector::ZeroVector;
+	const bool bOutOfCover = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::InCover) == false;
+	const bool bInDangerOfDeath = EnemyAgent->GetBeliefs()->GetBelief(GOAPFacts::InDangerOfDeath) == true;
+
+	if (bNoTarget || bOutOfCover || bInDangerOfDeath)
+	{
+		// Reset SuppressingTarget to false
+		EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::SuppressingTarget, false);
+		return true;
+	}
+	return false;
+}
+
+void USuppressPlayerAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
+{
+	// Suppressing is this member's own fact and stops when the action does, so nothing is written to the team's
+	// blackboard
+}
@@ -7,11 +7,17 @@
 #include "SuppressPlayerAction.generated.h"
 
 /**
- * 
+ * Stays in cover and keeps firing at where the squad last saw the target, whether this member can see it or not,
+ * until the target's position is lost or the member is in danger.
  */
 UCLASS()
 class AGP_API USuppressPlayerAction : public UAction
 {
 	GENERATED_BODY()
+	USuppressPlayerAction();
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 	
 };
@@ -1,3 +1,60 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "AGP/GoalActionOrientatedPlanning/TakeCoverAction.h"
 
+#include "EnemyAgent.h"
+#include "EnemyAgentBeliefs.h"
+#include "AGP/Characters/EnemyCharacter.h"
+
+namespace
+{
+	constexpr FGOAPActionDescriptor TakeCoverActionDescriptor = FGOAPActionDescriptor(1.0f)
+		.Requires(GOAPFacts::InDangerOfDeath, false)
+		.Causes(GOAPFacts::InCover, true);
+
+	// How close the member has to get to its cover position. The paths only go as far as the nearest node.
+	constexpr float ReachedPositionDistance = 300.0f;
+}
+
+UTakeCoverAction::UTakeCoverAction()
+{
+	SetDescriptor(TakeCoverActionDescriptor);
+}
+
+bool UTakeCoverAction::IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	// Only members of a squad are given somewhere to take cover
+	return Beliefs.GetBeliefsStateVectorsConst().FindRef("SquadPosition") != FVector::ZeroVector;
+}
+
+float UTakeCoverAction::GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const
+{
+	const float Cost = Super::GetCost(WorldState, Beliefs);
+	const UEnemyAgentBeliefs* EnemyBeliefs = Cast<UEnemyAgentBeliefs>(&Beliefs);
+	if (!EnemyBeliefs) return Cost;
+
+	return Cost + EnemyBeliefs->GetDistanceToSquadPosition() / 2000.0f;
+}
+
+void UTakeCoverAction::PerformAction(FGOAPActionContext& Context) const
+{
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
+	FVector CoverPosition = EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("SquadPosition");
+	EnemyCharacter->TickGoToLocation(CoverPosition);
+}
+
+bool UTakeCoverAction::IsActionComplete(const FGOAPActionContext& Context) const
+{
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	AEnemyCharacter* EnemyCharacter = Cast<AEnemyCharacter>(Context.Character);
+	const FVector CoverPosition = EnemyAgent->GetBeliefs()->GetBeliefsStateVectors().FindRef("SquadPosition");
+	return CoverPosition == FVector::ZeroVector ||
+		FVector::Dist(CoverPosition, EnemyCharacter->GetActorLocation()) <= ReachedPositionDistance;
+}
+
+void UTakeCoverAction::ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const
+{
+	// Being in cover is this member's own fact rather than the team's, so it is kept in its beliefs
+	UEnemyAgent* EnemyAgent = Cast<UEnemyAgent>(Context.Agent);
+	EnemyAgent->GetBeliefs()->SetBelief(GOAPFacts::InCover, true);
+}
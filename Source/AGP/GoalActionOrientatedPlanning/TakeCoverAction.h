@@ -7,11 +7,17 @@
 #include "TakeCoverAction.generated.h"
 
 /**
- * 
+ * Moves back to the position the member's squad picked for it to suppress from (the SquadPosition belief).
  */
 UCLASS()
 class AGP_API UTakeCoverAction : public UAction
 {
 	GENERATED_BODY()
+	UTakeCoverAction();
+	virtual bool IsActionPossible(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual float GetCost(const UWorldState& WorldState, const UBeliefs& Beliefs) const override;
+	virtual void PerformAction(FGOAPActionContext& Context) const override;
+	virtual bool IsActionComplete(const FGOAPActionContext& Context) const override;
+	virtual void ApplyEffects(FGOAPActionContext& Context, UWorldState& WorldState) const override;
 	
 };
@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LandscapeBuilder.h"
+
+#include "LandscapeCache.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/**
+	 * The surface is Z = H(X, Y) so the normal is (-dH/dX, -dH/dY, 1) and the tangent along X is (1, 0, dH/dX). Both
+	 * are normalised here.
+	 */
+	FORCEINLINE void WriteNormalAndTangent(float SlopeX, float SlopeY, FVector& OutNormal, FProcMeshTangent& OutTangent)
+	{
+		const float NormalScale = FMath::InvSqrt(SlopeX * SlopeX + SlopeY * SlopeY + 1.0f);
+		OutNormal = FVector(-SlopeX * NormalScale, -SlopeY * NormalScale, NormalScale);
+		const float TangentScale = FMath::InvSqrt(SlopeX * SlopeX + 1.0f);
+		OutTangent = FProcMeshTangent(FVector(TangentScale, 0.0f, SlopeX * TangentScale), false);
+	}
+}
+
+void FLandscapeBuilder::Build(const FLandscapeBuildSettings& Settings, FLandscapeBuildData& OutData)
+{
+	const int32 Width = Settings.Width;
+	const int32 Height = Settings.Height;
+
+	BuildHeights(Settings, OutData);
+	OutData.bHeightsOnly = false;
+
+	// Every vertex and quad is written to directly so the rows can be filled in parallel.
+	const int32 NumQuadsX = FMath::Max(Width - 1, 0);
+	const int32 NumQuadsY = FMath::Max(Height - 1, 0);
+	OutData.Vertices.SetNumUninitialized(Width * Height);
+	OutData.UVCoords.SetNumUninitialized(Width * Height);
+	OutData.Triangles.SetNumUninitialized(NumQuadsX * NumQuadsY * 6);
+	ParallelFor(Height, [&OutData, &Settings, Width, NumQuadsX, NumQuadsY](int32 Y)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			OutData.Vertices[Y * Width + X] = FVector(X * Settings.VertexSpacing, Y * Settings.VertexSpacing,
+				OutData.Heights[Y * Width + X]);
+			OutData.UVCoords[Y * Width + X] = FVector2D(X, Y);
+		}
+
+		// Ignore adding triangles if we are at the top of the grid.
+		if (Y >= NumQuadsY) return;
+		int32* Triangle = OutData.Triangles.GetData() + Y * NumQuadsX * 6;
+		for (int32 X = 0; X < NumQuadsX; X++)
+		{
+			*Triangle++ = Y * Width + X;
+			*Triangle++ = (Y+1) * Width + X;
+			*Triangle++ = Y * Width + X+1;
+			*Triangle++ = Y * Width + X+1;
+			*Triangle++ = (Y+1) * Width + X;
+			*Triangle++ = (Y+1) * Width + X+1;
+		}
+	});
+
+	OutData.Chunks = FLandscapeChunk::Partition(Width, Height, Settings.ChunkSize, OutData.NumChunksX,
+		OutData.NumChunksY);
+	OutData.ChunkMeshes.SetNum(OutData.Chunks.Num());
+
+	// Every level of detail has to be picked before any triangles are built so each chunk is stitched to the final
+	// level of detail of its neighbours.
+	for (FLandscapeChunk& Chunk : OutData.Chunks)
+	{
+		Chunk.LODStep = GetDesiredLODStep(Chunk, Settings.LandscapeTransform, Settings.VertexSpacing,
+			Settings.LODDistance, Settings.ViewLocations);
+	}
+
+	ParallelFor(OutData.Chunks.Num(), [&OutData, Width](int32 ChunkIndex)
+	{
+		const FLandscapeChunk& Chunk = OutData.Chunks[ChunkIndex];
+		FLandscapeChunkMesh& ChunkMesh = OutData.ChunkMeshes[ChunkIndex];
+		GatherChunkVertices(Chunk, Width, OutData.Vertices, OutData.Normals, OutData.UVCoords, OutData.Tangents,
+			ChunkMesh);
+		Chunk.BuildTriangles(GetChunkNeighbours(OutData.Chunks, OutData.NumChunksX, OutData.NumChunksY, ChunkIndex),
+			ChunkMesh.Triangles);
+	});
+}
+
+void FLandscapeBuilder::BuildHeights(const FLandscapeBuildSettings& Settings, FLandscapeBuildData& OutData)
+{
+	OutData.bHeightsOnly = true;
+	if (Settings.bUseCache && FLandscapeCache::Load(Settings, OutData)) return;
+
+	// Generate all of the heights up front. This is done in parallel over the rows of the grid.
+	const FLandscapeNoise Noise(Settings.Seed);
+	Noise.GenerateHeights(Settings.Width, Settings.Height, Settings.VertexSpacing, Settings.Noise, OutData.Heights);
+	if (Settings.Erosion.IsEnabled())
+	{
+		FLandscapeErosion::Erode(Settings.Width, Settings.Height, Settings.VertexSpacing, Settings.Erosion,
+			OutData.Heights);
+	}
+	CalculateGridNormalsAndTangents(OutData.Heights, Settings.Width, Settings.Height, Settings.VertexSpacing,
+		OutData.Normals, OutData.Tangents);
+
+	if (Settings.bUseCache)
+	{
+		FLandscapeCache::Save(Settings, OutData);
+	}
+}
+
+void FLandscapeBuilder::CalculateGridNormalsAndTangents(const TArray<float>& Heights, int32 Width, int32 Height,
+	float VertexSpacing, TArray<FVector>& OutNormals, TArray<FProcMeshTangent>& OutTangents)
+{
+	OutNormals.SetNumUninitialized(Width * Height);
+	OutTangents.SetNumUninitialized(Width * Height);
+	if (Width <= 0 || Height <= 0) return;
+
+	// Central differences span two vertices, while the one sided differences on the edges only span one.
+	const float InvCentralSpacing = VertexSpacing > 0.0f ? 0.5f / VertexSpacing : 0.0f;
+	const float InvEdgeSpacing = VertexSpacing > 0.0f ? 1.0f / VertexSpacing : 0.0f;
+	const float* HeightData = Heights.GetData();
+	FVector* NormalData = OutNormals.GetData();
+	FProcMeshTangent* TangentData = OutTangents.GetData();
+
+	ParallelFor(Height, [=](int32 Y)
+	{
+		const int32 YDown = FMath::Max(Y - 1, 0);
+		const int32 YUp = FMath::Min(Y + 1, Height - 1);
+		const float InvSpacingY = YUp - YDown == 2 ? InvCentralSpacing : (YUp > YDown ? InvEdgeSpacing : 0.0f);
+		const float* Row = HeightData + Y * Width;
+		const float* RowDown = HeightData + YDown * Width;
+		const float* RowUp = HeightData + YUp * Width;
+		FVector* NormalRow = NormalData + Y * Width;
+		FProcMeshTangent* TangentRow = TangentData + Y * Width;
+
+		if (Width == 1)
+		{
+			WriteNormalAndTangent(0.0f, (RowUp[0] - RowDown[0]) * InvSpacingY, NormalRow[0], TangentRow[0]);
+			return;
+		}
+
+		// The edge vertices are done separately so the inner loop has no branches.
+		WriteNormalAndTangent((Row[1] - Row[0]) * InvEdgeSpacing, (RowUp[0] - RowDown[0]) * InvSpacingY,
+			NormalRow[0], TangentRow[0]);
+		for (int32 X = 1; X < Width - 1; X++)
+		{
+			WriteNormalAndTangent((Row[X + 1] - Row[X - 1]) * InvCentralSpacing, (RowUp[X] - RowDown[X]) * InvSpacingY,
+				NormalRow[X], TangentRow[X]);
+		}
+		const int32 Last = Width - 1;
+		WriteNormalAndTangent((Row[Last] - Row[Last - 1]) * InvEdgeSpacing, (RowUp[Last] - RowDown[Last]) * InvSpacingY,
+			NormalRow[Last], TangentRow[Last]);
+	});
+}
+
+void FLandscapeBuilder::GatherChunkVertices(const FLandscapeChunk& Chunk, int32 Width, const TArray<FVector>& Vertices,
+	const TArray<FVector>& Normals, const TArray<FVector2D>& UVCoords, const TArray<FProcMeshTangent>& Tangents,
+	FLandscapeChunkMesh& OutChunkMesh)
+{
+	OutChunkMesh.Vertices.Reset(Chunk.GetNumVertices());
+	OutChunkMesh.Normals.Reset(Chunk.GetNumVertices());
+	OutChunkMesh.UVCoords.Reset(Chunk.GetNumVertices());
+	OutChunkMesh.Tangents.Reset(Chunk.GetNumVertices());
+
+	for (int32 LocalY = 0; LocalY < Chunk.GetNumVerticesY(); LocalY++)
+	{
+		for (int32 LocalX = 0; LocalX < Chunk.GetNumVerticesX(); LocalX++)
+		{
+			const int32 GridIndex = (Chunk.StartY + LocalY) * Width + Chunk.StartX + LocalX;
+			OutChunkMesh.Vertices.Add(Vertices[GridIndex]);
+			OutChunkMesh.UVCoords.Add(UVCoords[GridIndex]);
+			if (Normals.IsValidIndex(GridIndex))
+			{
+				OutChunkMesh.Normals.Add(Normals[GridIndex]);
+			}
+			if (Tangents.IsValidIndex(GridIndex))
+			{
+				OutChunkMesh.Tangents.Add(Tangents[GridIndex]);
+			}
+		}
+	}
+}
+
+int32 FLandscapeBuilder::GetDesiredLODStep(const FLandscapeChunk& Chunk, const FTransform& LandscapeTransform,
+	float VertexSpacing, float LODDistance, const TArray<FVector>& ViewLocations)
+{
+	if (ViewLocations.IsEmpty() || LODDistance <= 0.0f) return 1;
+
+	const FVector ChunkCentre = LandscapeTransform.TransformPosition(FVector(
+		(Chunk.StartX + Chunk.NumQuadsX * 0.5f) * VertexSpacing,
+		(Chunk.StartY + Chunk.NumQuadsY * 0.5f) * VertexSpacing,
+		0.0f));
+	float MinDistance = UE_MAX_FLT;
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		MinDistance = FMath::Min(MinDistance, FVector::Distance(ViewLocation, ChunkCentre));
+	}
+
+	const int32 MaxStep = FMath::Max(Chunk.NumQuadsX, Chunk.NumQuadsY);
+	int32 Step = 1;
+	float StepDistance = LODDistance;
+	while (MinDistance > StepDistance && Step < MaxStep)
+	{
+		Step *= 2;
+		StepDistance *= 2.0f;
+	}
+	return Chunk.ClampLODStep(Step);
+}
+
+FLandscapeChunkNeighbours FLandscapeBuilder::GetChunkNeighbours(const TArray<FLandscapeChunk>& Chunks,
+	int32 NumChunksX, int32 NumChunksY, int32 ChunkIndex)
+{
+	const int32 ChunkX = ChunkIndex % NumChunksX;
+	const int32 ChunkY = ChunkIndex / NumChunksX;
+	auto GetStep = [&Chunks](int32 NeighbourIndex)
+	{
+		return NeighbourIndex == INDEX_NONE ? 0 : Chunks[NeighbourIndex].LODStep;
+	};
+
+	FLandscapeChunkNeighbours Neighbours;
+	Neighbours.MinXStep = GetStep(GetChunkIndex(NumChunksX, NumChunksY, ChunkX - 1, ChunkY));
+	Neighbours.MaxXStep = GetStep(GetChunkIndex(NumChunksX, NumChunksY, ChunkX + 1, ChunkY));
+	Neighbours.MinYStep = GetStep(GetChunkIndex(NumChunksX, NumChunksY, ChunkX, ChunkY - 1));
+	Neighbours.MaxYStep = GetStep(GetChunkIndex(NumChunksX, NumChunksY, ChunkX, ChunkY + 1));
+	return Neighbours;
+}
+
+int32 FLandscapeBuilder::GetChunkIndex(int32 NumChunksX, int32 NumChunksY, int32 ChunkX, int32 ChunkY)
+{
+	if (ChunkX < 0 || ChunkY < 0 || ChunkX >= NumChunksX || ChunkY >= NumChunksY) return INDEX_NONE;
+	return ChunkY * NumChunksX + ChunkX;
+}
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LandscapeChunk.h"
+#include "LandscapeErosion.h"
+#include "LandscapeNoise.h"
+#include "ProceduralMeshComponent.h"
+
+/**
+ * The vertex data of a single chunk's mesh section. This is kept so that the chunk's triangles can be rebuilt when its
+ * level of detail changes without gathering the vertices again.
+ */
+struct FLandscapeChunkMesh
+{
+	TArray<FVector> Vertices;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UVCoords;
+	TArray<FProcMeshTangent> Tangents;
+	TArray<int32> Triangles;
+};
+
+/**
+ * Everything needed to build a landscape. This is a copy of the landscape's settings so that the build can run on
+ * another thread while the actor keeps being edited.
+ */
+struct FLandscapeBuildSettings
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	float VertexSpacing = 1000.0f;
+	// Together with the noise settings this fully decides the shape of the landscape.
+	int32 Seed = 0;
+	FLandscapeNoiseSettings Noise;
+	FLandscapeErosionSettings Erosion;
+	int32 ChunkSize = 32;
+	// If true the heights, normals and tangents are loaded from the on disk cache when possible, and saved to it
+	// when not.
+	bool bUseCache = false;
+
+	// Used to pick the level of detail each chunk starts at. Leave ViewLocations empty to build every chunk at full
+	// detail.
+	FTransform LandscapeTransform;
+	TArray<FVector> ViewLocations;
+	float LODDistance = 0.0f;
+};
+
+/**
+ * The result of building a landscape. Nothing in here has been given to any components yet.
+ */
+struct FLandscapeBuildData
+{
+	/**
+	 * True if only the heights, normals and tangents were built because the existing grid layout can be reused.
+	 */
+	bool bHeightsOnly = false;
+	TArray<float> Heights;
+	TArray<FVector> Vertices;
+	TArray<FVector2D> UVCoords;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FProcMeshTangent> Tangents;
+
+	TArray<FLandscapeChunk> Chunks;
+	TArray<FLandscapeChunkMesh> ChunkMeshes;
+	int32 NumChunksX = 0;
+	int32 NumChunksY = 0;
+};
+
+/**
+ * Builds all of the mesh data for a procedural landscape. None of this touches any UObjects so it can be run on a
+ * worker thread, leaving only the mesh section upload for the game thread.
+ */
+class AGP_API FLandscapeBuilder
+{
+public:
+	/**
+	 * Will generate the heights, vertices, triangles, normals and tangents of the landscape and split it into chunks.
+	 * @param Settings The settings of the landscape to build.
+	 * @param OutData The resulting mesh data.
+	 */
+	static void Build(const FLandscapeBuildSettings& Settings, FLandscapeBuildData& OutData);
+
+	/**
+	 * Will only generate the heights, normals and tangents of the landscape. The heights are eroded before the normals
+	 * are calculated. Used when the grid layout hasn't changed
+	 * so the existing vertices, triangles and chunks can be updated in place.
+	 * @param Settings The settings of the landscape to build.
+	 * @param OutData The resulting height data.
+	 */
+	static void BuildHeights(const FLandscapeBuildSettings& Settings, FLandscapeBuildData& OutData);
+
+	/**
+	 * Will calculate the normal and tangent of every vertex of a height grid from the central differences of the
+	 * neighbouring heights. This is far cheaper than the general CalculateTangentsForMesh since the grid layout means
+	 * no triangle adjacency has to be worked out. Rows are processed in parallel.
+	 * @param Heights The height of every vertex in row major order.
+	 * @param Width The grid width of the landscape.
+	 * @param Height The grid height of the landscape.
+	 * @param VertexSpacing The distance between neighbouring vertices.
+	 * @param OutNormals The resulting normals. Will be resized to Width * Height.
+	 * @param OutTangents The resulting tangents, pointing along the U (grid X) direction.
+	 */
+	static void CalculateGridNormalsAndTangents(const TArray<float>& Heights, int32 Width, int32 Height,
+		float VertexSpacing, TArray<FVector>& OutNormals, TArray<FProcMeshTangent>& OutTangents);
+
+	/**
+	 * Will copy the vertex data that lies within a chunk out of the landscape's full vertex data.
+	 * @param Chunk The chunk to gather the vertices of.
+	 * @param Width The grid width of the landscape.
+	 * @param OutChunkMesh The chunk mesh to fill. Its triangles are left untouched.
+	 */
+	static void GatherChunkVertices(const FLandscapeChunk& Chunk, int32 Width, const TArray<FVector>& Vertices,
+		const TArray<FVector>& Normals, const TArray<FVector2D>& UVCoords, const TArray<FProcMeshTangent>& Tangents,
+		FLandscapeChunkMesh& OutChunkMesh);
+
+	/**
+	 * Will find which level of detail a chunk should be drawn at. Each time the distance to the nearest camera doubles
+	 * past LODDistance the chunk is drawn with half as many quads along each side.
+	 * @param Chunk The chunk to find the level of detail of.
+	 * @param LandscapeTransform The world transform of the landscape.
+	 * @param VertexSpacing The distance between neighbouring vertices.
+	 * @param LODDistance The distance that chunks stop being drawn at full detail.
+	 * @param ViewLocations The world locations of the cameras.
+	 * @return A valid LODStep for the chunk.
+	 */
+	static int32 GetDesiredLODStep(const FLandscapeChunk& Chunk, const FTransform& LandscapeTransform,
+		float VertexSpacing, float LODDistance, const TArray<FVector>& ViewLocations);
+
+	/**
+	 * @return The level of detail steps of the chunks on each side of a chunk.
+	 */
+	static FLandscapeChunkNeighbours GetChunkNeighbours(const TArray<FLandscapeChunk>& Chunks, int32 NumChunksX,
+		int32 NumChunksY, int32 ChunkIndex);
+
+	/**
+	 * @return The index of the chunk at the given chunk coordinates, or INDEX_NONE if it is outside the landscape.
+	 */
+	static int32 GetChunkIndex(int32 NumChunksX, int32 NumChunksY, int32 ChunkX, int32 ChunkY);
+};
@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LandscapeCache.h"
+
+#include "LandscapeBuilder.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr uint32 CacheMagic = 0x4C504741; // "AGPL"
+	// Bump this whenever the file layout or the generation algorithm changes so old files are ignored.
+	constexpr uint32 CacheVersion = 2;
+
+	/**
+	 * Written at the start of every cache file. Holds every setting that affects the heights so a file is only used
+	 * if it was generated with exactly the same settings, even if two sets of settings share a hash.
+	 */
+	struct FLandscapeCacheHeader
+	{
+		uint32 Magic = CacheMagic;
+		uint32 Version = CacheVersion;
+		int32 Seed = 0;
+		int32 Width = 0;
+		int32 Height = 0;
+		float VertexSpacing = 0.0f;
+		float Scale = 0.0f;
+		float Roughness = 0.0f;
+		float Offset = 0.0f;
+		int32 Octaves = 0;
+		float Lacunarity = 0.0f;
+		float Gain = 0.0f;
+		int32 ThermalIterations = 0;
+		float TalusAngle = 0.0f;
+		float ThermalRate = 0.0f;
+		int32 HydraulicIterations = 0;
+		float RainAmount = 0.0f;
+		float SedimentCapacity = 0.0f;
+		float ErosionRate = 0.0f;
+		float DepositionRate = 0.0f;
+		float EvaporationRate = 0.0f;
+
+		explicit FLandscapeCacheHeader(const FLandscapeBuildSettings& Settings)
+			: Seed(Settings.Seed)
+			, Width(Settings.Width)
+			, Height(Settings.Height)
+			, VertexSpacing(Settings.VertexSpacing)
+			, Scale(Settings.Noise.Scale)
+			, Roughness(Settings.Noise.Roughness)
+			, Offset(Settings.Noise.Offset)
+			, Octaves(Settings.Noise.Octaves)
+			, Lacunarity(Settings.Noise.Lacunarity)
+			, Gain(Settings.Noise.Gain)
+			, ThermalIterations(Settings.Erosion.ThermalIterations)
+			, TalusAngle(Settings.Erosion.TalusAngle)
+			, ThermalRate(Settings.Erosion.ThermalRate)
+			, HydraulicIterations(Settings.Erosion.HydraulicIterations)
+			, RainAmount(Settings.Erosion.RainAmount)
+			, SedimentCapacity(Settings.Erosion.SedimentCapacity)
+			, ErosionRate(Settings.Erosion.ErosionRate)
+			, DepositionRate(Settings.Erosion.DepositionRate)
+			, EvaporationRate(Settings.Erosion.EvaporationRate)
+		{
+		}
+
+		bool operator==(const FLandscapeCacheHeader& Other) const
+		{
+			// Every member is four bytes so there is no padding to worry about.
+			return FMemory::Memcmp(this, &Other, sizeof(FLandscapeCacheHeader)) == 0;
+		}
+	};
+	static_assert(sizeof(FLandscapeCacheHeader) == 21 * 4, "The cache header must not have any padding.");
+
+	/**
+	 * After the header the file holds the heights, then the normals, then the X tangents. Normals and tangents are
+	 * stored at single precision to keep the file small.
+	 */
+	int64 GetCacheFileSize(int32 NumVertices)
+	{
+		return sizeof(FLandscapeCacheHeader)
+			+ NumVertices * (sizeof(float) + sizeof(FVector3f) + sizeof(FVector3f));
+	}
+}
+
+FString FLandscapeCache::GetCacheFilePath(const FLandscapeBuildSettings& Settings)
+{
+	const FLandscapeCacheHeader Header(Settings);
+	const uint32 Hash = FCrc::MemCrc32(&Header, sizeof(FLandscapeCacheHeader));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("LandscapeCache"),
+		FString::Printf(TEXT("Landscape_%08x.bin"), Hash));
+}
+
+bool FLandscapeCache::Load(const FLandscapeBuildSettings& Settings, FLandscapeBuildData& OutData)
+{
+	const int32 NumVertices = Settings.Width * Settings.Height;
+	if (NumVertices <= 0) return false;
+
+	const FString FilePath = GetCacheFilePath(Settings);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*FilePath)) return false;
+
+	// The region has to be released before the file handle, which the declaration order takes care of.
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+	if (!MappedFile || MappedFile->GetFileSize() != GetCacheFileSize(NumVertices)) return false;
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion());
+	if (!MappedRegion) return false;
+
+	const uint8* Data = MappedRegion->GetMappedPtr();
+	FLandscapeCacheHeader Header(Settings);
+	FMemory::Memcpy(&Header, Data, sizeof(FLandscapeCacheHeader));
+	if (!(Header == FLandscapeCacheHeader(Settings)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Landscape cache file %s doesn't match its settings. Ignoring it."), *FilePath)
+		return false;
+	}
+	Data += sizeof(FLandscapeCacheHeader);
+
+	OutData.Heights.SetNumUninitialized(NumVertices);
+	FMemory::Memcpy(OutData.Heights.GetData(), Data, NumVertices * sizeof(float));
+	Data += NumVertices * sizeof(float);
+
+	const FVector3f* CachedNormals = reinterpret_cast<const FVector3f*>(Data);
+	const FVector3f* CachedTangents = CachedNormals + NumVertices;
+	OutData.Normals.SetNumUninitialized(NumVertices);
+	OutData.Tangents.SetNumUninitialized(NumVertices);
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		OutData.Normals[VertexIndex] = FVector(CachedNormals[VertexIndex]);
+		OutData.Tangents[VertexIndex] = FProcMeshTangent(FVector(CachedTangents[VertexIndex]), false);
+	}
+	return true;
+}
+
+bool FLandscapeCache::Save(const FLandscapeBuildSettings& Settings, const FLandscapeBuildData& Data)
+{
+	const int32 NumVertices = Settings.Width * Settings.Height;
+	if (NumVertices <= 0 || Data.Heights.Num() != NumVertices || Data.Normals.Num() != NumVertices
+		|| Data.Tangents.Num() != NumVertices) return false;
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(GetCacheFileSize(NumVertices));
+	uint8* Write = Bytes.GetData();
+
+	const FLandscapeCacheHeader Header(Settings);
+	FMemory::Memcpy(Write, &Header, sizeof(FLandscapeCacheHeader));
+	Write += sizeof(FLandscapeCacheHeader);
+
+	FMemory::Memcpy(Write, Data.Heights.GetData(), NumVertices * sizeof(float));
+	Write += NumVertices * sizeof(float);
+
+	FVector3f* CachedNormals = reinterpret_cast<FVector3f*>(Write);
+	FVector3f* CachedTangents = CachedNormals + NumVertices;
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		CachedNormals[VertexIndex] = FVector3f(Data.Normals[VertexIndex]);
+		CachedTangents[VertexIndex] = FVector3f(Data.Tangents[VertexIndex].TangentX);
+	}
+
+	// Write to a temporary file first so that a half written file is never picked up by Load. Each save gets its own
+	// temporary file so that landscapes with the same settings saving at once don't write over each other's.
+	const FString FilePath = GetCacheFilePath(Settings);
+	const FString TempFilePath = FPaths::CreateTempFilename(*FPaths::GetPath(FilePath),
+		*FPaths::GetBaseFilename(FilePath), TEXT(".tmp"));
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempFilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Unable to write landscape cache file %s"), *TempFilePath)
+		return false;
+	}
+	if (!IFileManager::Get().Move(*FilePath, *TempFilePath, true))
+	{
+		IFileManager::Get().Delete(*TempFilePath);
+		return false;
+	}
+	return true;
+}
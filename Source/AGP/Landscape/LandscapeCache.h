@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FLandscapeBuildSettings;
+struct FLandscapeBuildData;
+
+/**
+ * Stores the generated heights, normals and tangents of landscapes on disk so that a landscape with the same
+ * generation settings can be loaded instead of generated again. Files live in Saved/LandscapeCache and are named
+ * after a hash of the settings. Everything else the landscape needs (vertices, triangles, chunks and the navigation
+ * grid) only depends on the grid size so it is quicker to rebuild than to load.
+ */
+class AGP_API FLandscapeCache
+{
+public:
+	/**
+	 * @return The file that a landscape with these settings would be cached in.
+	 */
+	static FString GetCacheFilePath(const FLandscapeBuildSettings& Settings);
+
+	/**
+	 * Will memory map the cache file for these settings and copy out its heights, normals and tangents.
+	 * @param Settings The settings of the landscape to load.
+	 * @param OutData Will have its heights, normals and tangents filled if the load succeeds.
+	 * @return False if there is no valid cache file for these settings.
+	 */
+	static bool Load(const FLandscapeBuildSettings& Settings, FLandscapeBuildData& OutData);
+
+	/**
+	 * Will write the heights, normals and tangents of a build to the cache file for its settings.
+	 * @param Settings The settings the data was built with.
+	 * @param Data The built data.
+	 * @return False if the file couldn't be written.
+	 */
+	static bool Save(const FLandscapeBuildSettings& Settings, const FLandscapeBuildData& Data);
+};
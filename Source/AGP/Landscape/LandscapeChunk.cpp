@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LandscapeChunk.h"
+
+bool FLandscapeChunk::IsValidLODStep(int32 Step) const
+{
+	if (Step == 1) return true;
+	return Step > 1
+		&& NumQuadsX % Step == 0 && NumQuadsY % Step == 0
+		&& NumQuadsX / Step >= 2 && NumQuadsY / Step >= 2;
+}
+
+int32 FLandscapeChunk::ClampLODStep(int32 Step) const
+{
+	while (Step > 1 && !IsValidLODStep(Step))
+	{
+		Step /= 2;
+	}
+	return FMath::Max(Step, 1);
+}
+
+void FLandscapeChunk::BuildTriangles(const FLandscapeChunkNeighbours& Neighbours, TArray<int32>& OutTriangles) const
+{
+	OutTriangles.Reset();
+	const int32 Step = LODStep;
+
+	// Too thin to have a ring around the outside. Only step 1 is valid for these so there is nothing to stitch.
+	if (NumQuadsX < 2 || NumQuadsY < 2)
+	{
+		for (int32 Y = 0; Y < NumQuadsY; Y++)
+		{
+			for (int32 X = 0; X < NumQuadsX; X++)
+			{
+				AddTriangle(OutTriangles, X, Y, X, Y + 1, X + 1, Y);
+				AddTriangle(OutTriangles, X + 1, Y, X, Y + 1, X + 1, Y + 1);
+			}
+		}
+		return;
+	}
+
+	// The inside of the chunk is a regular grid of quads, leaving a ring of quads one step wide around the outside.
+	for (int32 Y = Step; Y < NumQuadsY - Step; Y += Step)
+	{
+		for (int32 X = Step; X < NumQuadsX - Step; X += Step)
+		{
+			AddTriangle(OutTriangles, X, Y, X, Y + Step, X + Step, Y);
+			AddTriangle(OutTriangles, X + Step, Y, X, Y + Step, X + Step, Y + Step);
+		}
+	}
+
+	// Each side of the ring joins the inner grid to the chunk edge. If the chunk on the other side of an edge is
+	// coarser then only its vertices are used along the edge, so both chunks share exactly the same edge.
+	AddEdgeStrip(OutTriangles, true, 0, Step, NumQuadsX, FMath::Max(Step, Neighbours.MinYStep));
+	AddEdgeStrip(OutTriangles, true, NumQuadsY, NumQuadsY - Step, NumQuadsX, FMath::Max(Step, Neighbours.MaxYStep));
+	AddEdgeStrip(OutTriangles, false, 0, Step, NumQuadsY, FMath::Max(Step, Neighbours.MinXStep));
+	AddEdgeStrip(OutTriangles, false, NumQuadsX, NumQuadsX - Step, NumQuadsY, FMath::Max(Step, Neighbours.MaxXStep));
+}
+
+TArray<FLandscapeChunk> FLandscapeChunk::Partition(int32 GridWidth, int32 GridHeight, int32 ChunkSize,
+	int32& OutNumChunksX, int32& OutNumChunksY)
+{
+	TArray<int32> StartsX, SizesX, StartsY, SizesY;
+	PartitionAxis(GridWidth - 1, ChunkSize, StartsX, SizesX);
+	PartitionAxis(GridHeight - 1, ChunkSize, StartsY, SizesY);
+	OutNumChunksX = StartsX.Num();
+	OutNumChunksY = StartsY.Num();
+
+	TArray<FLandscapeChunk> Chunks;
+	Chunks.Reserve(OutNumChunksX * OutNumChunksY);
+	for (int32 ChunkY = 0; ChunkY < OutNumChunksY; ChunkY++)
+	{
+		for (int32 ChunkX = 0; ChunkX < OutNumChunksX; ChunkX++)
+		{
+			FLandscapeChunk Chunk;
+			Chunk.StartX = StartsX[ChunkX];
+			Chunk.StartY = StartsY[ChunkY];
+			Chunk.NumQuadsX = SizesX[ChunkX];
+			Chunk.NumQuadsY = SizesY[ChunkY];
+			Chunks.Add(Chunk);
+		}
+	}
+	return Chunks;
+}
+
+void FLandscapeChunk::PartitionAxis(int32 NumQuads, int32 ChunkSize, TArray<int32>& OutStarts, TArray<int32>& OutSizes)
+{
+	if (NumQuads <= 0) return;
+	ChunkSize = FMath::Max(ChunkSize, 2);
+	for (int32 Start = 0; Start < NumQuads; Start += ChunkSize)
+	{
+		OutStarts.Add(Start);
+		OutSizes.Add(FMath::Min(ChunkSize, NumQuads - Start));
+	}
+	// A chunk needs at least two quads across for its edges to be stitched, so merge a single leftover quad.
+	if (OutSizes.Num() > 1 && OutSizes.Last() < 2)
+	{
+		OutSizes[OutSizes.Num() - 2] += OutSizes.Last();
+		OutStarts.Pop();
+		OutSizes.Pop();
+	}
+}
+
+void FLandscapeChunk::AddTriangle(TArray<int32>& OutTriangles, int32 AX, int32 AY, int32 BX, int32 BY, int32 CX, int32 CY) const
+{
+	// Keep the same winding as the rest of the landscape (clockwise in grid space) whichever order the
+	// corners were given in.
+	const int32 Cross = (BX - AX) * (CY - AY) - (BY - AY) * (CX - AX);
+	if (Cross > 0)
+	{
+		Swap(BX, CX);
+		Swap(BY, CY);
+	}
+	OutTriangles.Add(GetLocalVertexIndex(AX, AY));
+	OutTriangles.Add(GetLocalVertexIndex(BX, BY));
+	OutTriangles.Add(GetLocalVertexIndex(CX, CY));
+}
+
+void FLandscapeChunk::AddEdgeStrip(TArray<int32>& OutTriangles, bool bAlongX, int32 OuterFixed, int32 InnerFixed,
+	int32 EdgeLength, int32 OuterStep) const
+{
+	// The strip is a trapezoid between the outer edge, which runs the full length of the chunk, and the edge of the
+	// inner grid, which is inset by one step at both ends. The two lines are zipped together by always advancing
+	// along whichever line has the nearer next vertex.
+	const int32 Step = LODStep;
+	const int32 InnerStart = Step;
+	const int32 InnerEnd = EdgeLength - Step;
+
+	auto ToLocal = [bAlongX](int32 Along, int32 Fixed, int32& OutX, int32& OutY)
+	{
+		OutX = bAlongX ? Along : Fixed;
+		OutY = bAlongX ? Fixed : Along;
+	};
+
+	int32 Outer = 0;
+	int32 Inner = InnerStart;
+	while (Outer < EdgeLength || Inner < InnerEnd)
+	{
+		const bool bAdvanceOuter = Inner >= InnerEnd || (Outer < EdgeLength && Outer + OuterStep <= Inner + Step);
+		int32 AX, AY, BX, BY, CX, CY;
+		ToLocal(Outer, OuterFixed, AX, AY);
+		ToLocal(Inner, InnerFixed, CX, CY);
+		if (bAdvanceOuter)
+		{
+			ToLocal(Outer + OuterStep, OuterFixed, BX, BY);
+			Outer += OuterStep;
+		}
+		else
+		{
+			ToLocal(Inner + Step, InnerFixed, BX, BY);
+			Inner += Step;
+		}
+		AddTriangle(OutTriangles, AX, AY, BX, BY, CX, CY);
+	}
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The level of detail steps of the chunks on each side of a chunk. A step of 0 means there is no chunk on that side.
+ */
+struct FLandscapeChunkNeighbours
+{
+	int32 MinXStep = 0;
+	int32 MaxXStep = 0;
+	int32 MinYStep = 0;
+	int32 MaxYStep = 0;
+};
+
+/**
+ * A rectangular block of the landscape grid that is drawn as its own mesh section. Chunks that share an edge share the
+ * vertices along that edge, so each chunk has (NumQuadsX + 1) * (NumQuadsY + 1) vertices.
+ */
+struct AGP_API FLandscapeChunk
+{
+	// The grid coordinates of the first vertex in this chunk.
+	int32 StartX = 0;
+	int32 StartY = 0;
+	int32 NumQuadsX = 0;
+	int32 NumQuadsY = 0;
+
+	/**
+	 * How many grid quads make up one quad of this chunk at its current level of detail. Always a power of two.
+	 */
+	int32 LODStep = 1;
+
+	int32 GetNumVerticesX() const { return NumQuadsX + 1; }
+	int32 GetNumVerticesY() const { return NumQuadsY + 1; }
+	int32 GetNumVertices() const { return GetNumVerticesX() * GetNumVerticesY(); }
+
+	/**
+	 * @return The index of the given chunk-local grid position within this chunk's vertex buffer.
+	 */
+	int32 GetLocalVertexIndex(int32 LocalX, int32 LocalY) const { return LocalY * GetNumVerticesX() + LocalX; }
+
+	/**
+	 * @return True if this chunk can be drawn with quads that are Step grid quads wide. The step must divide the chunk
+	 * evenly and leave at least two quads along each side so that the edges can be stitched to their neighbours.
+	 */
+	bool IsValidLODStep(int32 Step) const;
+
+	/**
+	 * @return The largest step that is no larger than the requested step and is valid for this chunk.
+	 */
+	int32 ClampLODStep(int32 Step) const;
+
+	/**
+	 * Will build the index buffer for this chunk at its current LODStep. Any edge that borders a chunk with a coarser
+	 * step is stitched to that coarser step so that no cracks appear between the chunks.
+	 * @param Neighbours The steps of the neighbouring chunks.
+	 * @param OutTriangles The resulting triangle indices, relative to this chunk's vertex buffer.
+	 */
+	void BuildTriangles(const FLandscapeChunkNeighbours& Neighbours, TArray<int32>& OutTriangles) const;
+
+	/**
+	 * Will split a grid of vertices into chunks. If the grid does not divide evenly then the last chunk in a row or
+	 * column is smaller. A leftover strip of a single quad is merged into the chunk before it.
+	 * @param GridWidth The number of vertices along the X axis.
+	 * @param GridHeight The number of vertices along the Y axis.
+	 * @param ChunkSize The number of quads along each side of a full chunk.
+	 * @param OutNumChunksX The number of chunks along the X axis.
+	 * @param OutNumChunksY The number of chunks along the Y axis.
+	 * @return The chunks in row major order.
+	 */
+	static TArray<FLandscapeChunk> Partition(int32 GridWidth, int32 GridHeight, int32 ChunkSize,
+		int32& OutNumChunksX, int32& OutNumChunksY);
+
+private:
+	static void PartitionAxis(int32 NumQuads, int32 ChunkSize, TArray<int32>& OutStarts, TArray<int32>& OutSizes);
+
+	void AddTriangle(TArray<int32>& OutTriangles, int32 AX, int32 AY, int32 BX, int32 BY, int32 CX, int32 CY) const;
+	void AddEdgeStrip(TArray<int32>& OutTriangles, bool bAlongX, int32 OuterFixed, int32 InnerFixed, int32 EdgeLength,
+		int32 OuterStep) const;
+};
@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LandscapeErosion.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// Square tiles keep the neighbouring rows that each vertex reads from in cache while a tile is processed.
+	constexpr int32 TileSize = 64;
+
+	// The four neighbours of a vertex, in the order +X, -X, +Y, -Y.
+	constexpr int32 NumDirections = 4;
+	constexpr int32 DirectionX[NumDirections] = { 1, -1, 0, 0 };
+	constexpr int32 DirectionY[NumDirections] = { 0, 0, 1, -1 };
+	// The direction that points back from a neighbour to the vertex.
+	constexpr int32 OppositeDirection[NumDirections] = { 1, 0, 3, 2 };
+
+	/**
+	 * Will call Function(Index, X, Y) for every vertex of the grid. Tiles are processed in parallel.
+	 */
+	template<typename FunctionType>
+	void ParallelForEachVertex(int32 Width, int32 Height, const FunctionType& Function)
+	{
+		const int32 NumTilesX = FMath::DivideAndRoundUp(Width, TileSize);
+		const int32 NumTilesY = FMath::DivideAndRoundUp(Height, TileSize);
+		ParallelFor(NumTilesX * NumTilesY, [&](int32 TileIndex)
+		{
+			const int32 StartX = (TileIndex % NumTilesX) * TileSize;
+			const int32 StartY = (TileIndex / NumTilesX) * TileSize;
+			const int32 EndX = FMath::Min(StartX + TileSize, Width);
+			const int32 EndY = FMath::Min(StartY + TileSize, Height);
+			for (int32 Y = StartY; Y < EndY; Y++)
+			{
+				for (int32 X = StartX; X < EndX; X++)
+				{
+					Function(Y * Width + X, X, Y);
+				}
+			}
+		});
+	}
+
+	FORCEINLINE bool IsInGrid(int32 X, int32 Y, int32 Width, int32 Height)
+	{
+		return X >= 0 && Y >= 0 && X < Width && Y < Height;
+	}
+}
+
+void FLandscapeErosion::Erode(int32 Width, int32 Height, float VertexSpacing, const FLandscapeErosionSettings& Settings,
+	TArray<float>& InOutHeights)
+{
+	if (Width <= 0 || Height <= 0 || InOutHeights.Num() != Width * Height) return;
+	if (Settings.ThermalIterations > 0)
+	{
+		ErodeThermal(Width, Height, VertexSpacing, Settings, InOutHeights);
+	}
+	if (Settings.HydraulicIterations > 0)
+	{
+		ErodeHydraulic(Width, Height, Settings, InOutHeights);
+	}
+}
+
+void FLandscapeErosion::ErodeThermal(int32 Width, int32 Height, float VertexSpacing,
+	const FLandscapeErosionSettings& Settings, TArray<float>& InOutHeights)
+{
+	// Any height difference to a neighbour above this is steeper than the talus angle.
+	const float TalusHeight = FMath::Tan(FMath::DegreesToRadians(Settings.TalusAngle)) * VertexSpacing;
+	const float Rate = FMath::Clamp(Settings.ThermalRate, 0.0f, 1.0f);
+
+	TArray<float> Outflow;
+	Outflow.SetNumZeroed(Width * Height * NumDirections);
+	float* Heights = InOutHeights.GetData();
+	float* Flow = Outflow.GetData();
+
+	for (int32 Iteration = 0; Iteration < Settings.ThermalIterations; Iteration++)
+	{
+		// Work out how much material each vertex sheds to each of its lower neighbours. The material is shared out
+		// in proportion to how far past the talus angle each neighbour is.
+		ParallelForEachVertex(Width, Height, [=](int32 Index, int32 X, int32 Y)
+		{
+			float Excess[NumDirections];
+			float TotalExcess = 0.0f;
+			float MaxExcess = 0.0f;
+			for (int32 Direction = 0; Direction < NumDirections; Direction++)
+			{
+				const int32 NeighbourX = X + DirectionX[Direction];
+				const int32 NeighbourY = Y + DirectionY[Direction];
+				Excess[Direction] = IsInGrid(NeighbourX, NeighbourY, Width, Height)
+					? FMath::Max(Heights[Index] - Heights[NeighbourY * Width + NeighbourX] - TalusHeight, 0.0f)
+					: 0.0f;
+				TotalExcess += Excess[Direction];
+				MaxExcess = FMath::Max(MaxExcess, Excess[Direction]);
+			}
+
+			// Moving half of the largest excess would level that slope, so never move more than that.
+			const float Amount = TotalExcess > 0.0f ? Rate * 0.5f * MaxExcess / TotalExcess : 0.0f;
+			for (int32 Direction = 0; Direction < NumDirections; Direction++)
+			{
+				Flow[Index * NumDirections + Direction] = Excess[Direction] * Amount;
+			}
+		});
+
+		// Every vertex only writes to itself here, gathering what its neighbours shed towards it.
+		ParallelForEachVertex(Width, Height, [=](int32 Index, int32 X, int32 Y)
+		{
+			float Change = 0.0f;
+			for (int32 Direction = 0; Direction < NumDirections; Direction++)
+			{
+				Change -= Flow[Index * NumDirections + Direction];
+				const int32 NeighbourX = X + DirectionX[Direction];
+				const int32 NeighbourY = Y + DirectionY[Direction];
+				if (IsInGrid(NeighbourX, NeighbourY, Width, Height))
+				{
+					Change += Flow[(NeighbourY * Width + NeighbourX) * NumDirections + OppositeDirection[Direction]];
+				}
+			}
+			Heights[Index] += Change;
+		});
+	}
+}
+
+void FLandscapeErosion::ErodeHydraulic(int32 Width, int32 Height, const FLandscapeErosionSettings& Settings,
+	TArray<float>& InOutHeights)
+{
+	const int32 NumVertices = Width * Height;
+	const float Evaporation = FMath::Clamp(1.0f - Settings.EvaporationRate, 0.0f, 1.0f);
+	const float ErosionRate = FMath::Clamp(Settings.ErosionRate, 0.0f, 1.0f);
+	const float DepositionRate = FMath::Clamp(Settings.DepositionRate, 0.0f, 1.0f);
+
+	// Water and sediment are double buffered so the gather pass only ever reads the previous iteration's values.
+	TArray<float> Water, NextWater, Sediment, NextSediment, Outflow;
+	Water.SetNumZeroed(NumVertices);
+	NextWater.SetNumZeroed(NumVertices);
+	Sediment.SetNumZeroed(NumVertices);
+	NextSediment.SetNumZeroed(NumVertices);
+	Outflow.SetNumZeroed(NumVertices * NumDirections);
+	float* Heights = InOutHeights.GetData();
+	float* Flow = Outflow.GetData();
+
+	// The first rain fall.
+	for (float& WaterAmount : Water)
+	{
+		WaterAmount = Settings.RainAmount;
+	}
+
+	for (int32 Iteration = 0; Iteration < Settings.HydraulicIterations; Iteration++)
+	{
+		const float* WaterData = Water.GetData();
+		float* NextWaterData = NextWater.GetData();
+		const float* SedimentData = Sediment.GetData();
+		float* NextSedimentData = NextSediment.GetData();
+
+		// Work out how much water flows to each lower neighbour based on the water surface heights.
+		ParallelForEachVertex(Width, Height, [=](int32 Index, int32 X, int32 Y)
+		{
+			const float Surface = Heights[Index] + WaterData[Index];
+
+			float Difference[NumDirections];
+			float TotalDifference = 0.0f;
+			float MaxDifference = 0.0f;
+			for (int32 Direction = 0; Direction < NumDirections; Direction++)
+			{
+				const int32 NeighbourX = X + DirectionX[Direction];
+				const int32 NeighbourY = Y + DirectionY[Direction];
+				if (IsInGrid(NeighbourX, NeighbourY, Width, Height))
+				{
+					const int32 NeighbourIndex = NeighbourY * Width + NeighbourX;
+					const float NeighbourSurface = Heights[NeighbourIndex] + WaterData[NeighbourIndex];
+					Difference[Direction] = FMath::Max(Surface - NeighbourSurface, 0.0f);
+				} else
+				{
+					Difference[Direction] = 0.0f;
+				}
+				TotalDifference += Difference[Direction];
+				MaxDifference = FMath::Max(MaxDifference, Difference[Direction]);
+			}
+
+			const float Amount = TotalDifference > 0.0f
+				? FMath::Min(WaterData[Index], 0.5f * MaxDifference) / TotalDifference
+				: 0.0f;
+			for (int32 Direction = 0; Direction < NumDirections; Direction++)
+			{
+				Flow[Index * NumDirections + Direction] = Difference[Direction] * Amount;
+			}
+		});
+
+		// Gather the water and the sediment it carries, then erode or deposit depending on how much sediment the
+		// water moving through this vertex is able to carry.
+		ParallelForEachVertex(Width, Height, [=](int32 Index, int32 X, int32 Y)
+		{
+			float OutWater = 0.0f;
+			float InWater = 0.0f;
+			float InSediment = 0.0f;
+			for (int32 Direction = 0; Direction < NumDirections; Direction++)
+			{
+				OutWater += Flow[Index * NumDirections + Direction];
+				const int32 NeighbourX = X + DirectionX[Direction];
+				const int32 NeighbourY = Y + DirectionY[Direction];
+				if (!IsInGrid(NeighbourX, NeighbourY, Width, Height)) continue;
+
+				const int32 NeighbourIndex = NeighbourY * Width + NeighbourX;
+				const float NeighbourFlow = Flow[NeighbourIndex * NumDirections + OppositeDirection[Direction]];
+				InWater += NeighbourFlow;
+				if (WaterData[NeighbourIndex] > 0.0f)
+				{
+					// Sediment moves at the same concentration as the water it is in.
+					InSediment += SedimentData[NeighbourIndex] * NeighbourFlow / WaterData[NeighbourIndex];
+				}
+			}
+
+			const float OutSediment = WaterData[Index] > 0.0f
+				? SedimentData[Index] * OutWater / WaterData[Index]
+				: 0.0f;
+			float NewSediment = SedimentData[Index] - OutSediment + InSediment;
+			const float NewWater = WaterData[Index] - OutWater + InWater;
+
+			// Fast moving water is able to carry more sediment.
+			const float Capacity = Settings.SedimentCapacity * (OutWater + InWater);
+			if (NewSediment > Capacity)
+			{
+				const float Deposited = DepositionRate * (NewSediment - Capacity);
+				Heights[Index] += Deposited;
+				NewSediment -= Deposited;
+			} else
+			{
+				const float Eroded = ErosionRate * (Capacity - NewSediment);
+				Heights[Index] -= Eroded;
+				NewSediment += Eroded;
+			}
+
+			// The next iteration's rain is added here so that the outflow pass never writes to the water.
+			NextWaterData[Index] = NewWater * Evaporation + Settings.RainAmount;
+			NextSedimentData[Index] = NewSediment;
+		});
+
+		Swap(Water, NextWater);
+		Swap(Sediment, NextSediment);
+	}
+
+	// Whatever sediment is still being carried settles where it is.
+	for (int32 Index = 0; Index < NumVertices; Index++)
+	{
+		Heights[Index] += Sediment[Index];
+	}
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The settings of the erosion passes that are run over the landscape heights after the noise has been generated.
+ * Either pass is skipped if its number of iterations is zero.
+ */
+struct FLandscapeErosionSettings
+{
+	// Thermal erosion moves material down any slope that is steeper than the talus angle.
+	int32 ThermalIterations = 0;
+	float TalusAngle = 35.0f;
+	float ThermalRate = 0.5f;
+
+	// Hydraulic erosion rains water onto every vertex which then flows downhill, carrying sediment with it.
+	int32 HydraulicIterations = 0;
+	float RainAmount = 2.0f;
+	float SedimentCapacity = 0.5f;
+	float ErosionRate = 0.3f;
+	float DepositionRate = 0.3f;
+	float EvaporationRate = 0.05f;
+
+	bool IsEnabled() const { return ThermalIterations > 0 || HydraulicIterations > 0; }
+};
+
+/**
+ * Erodes a height grid in place. Each iteration is split into a pass that works out how much flows out of every
+ * vertex and a pass that gathers what flows into it, so no two threads ever write to the same vertex. The grid is
+ * processed in tiles across all cores and the result doesn't depend on the order the tiles run in, so the same
+ * heights always erode the same way.
+ */
+class AGP_API FLandscapeErosion
+{
+public:
+	/**
+	 * Will run the thermal and then the hydraulic erosion passes over the heights.
+	 * @param Width The grid width of the landscape.
+	 * @param Height The grid height of the landscape.
+	 * @param VertexSpacing The distance between neighbouring vertices.
+	 * @param Settings The erosion settings to use.
+	 * @param InOutHeights The heights to erode, in row major order.
+	 */
+	static void Erode(int32 Width, int32 Height, float VertexSpacing, const FLandscapeErosionSettings& Settings,
+		TArray<float>& InOutHeights);
+
+private:
+	static void ErodeThermal(int32 Width, int32 Height, float VertexSpacing, const FLandscapeErosionSettings& Settings,
+		TArray<float>& InOutHeights);
+	static void ErodeHydraulic(int32 Width, int32 Height, const FLandscapeErosionSettings& Settings,
+		TArray<float>& InOutHeights);
+};
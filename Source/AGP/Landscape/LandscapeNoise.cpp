@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LandscapeNoise.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// The gradients are the corners and major axes of a square. Storing them as two tables instead of a switch keeps
+	// the inner loop branch free so the compiler is able to vectorise it.
+	constexpr float GradientX[8] = { 1.0f, 1.0f, 0.0f, -1.0f, -1.0f, -1.0f, 0.0f, 1.0f };
+	constexpr float GradientY[8] = { 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, -1.0f, -1.0f, -1.0f };
+
+	// Rows are processed in blocks so the temporary buffers can live on the stack.
+	constexpr int32 RowBlockSize = 64;
+
+	// Shifts each octave so that the lattice points of different octaves don't line up at the origin.
+	constexpr float OctaveShift = 19.19f;
+
+	FORCEINLINE float Fade(float T)
+	{
+		return T * T * T * (T * (T * 6.0f - 15.0f) + 10.0f);
+	}
+}
+
+FLandscapeNoise::FLandscapeNoise(int32 Seed)
+{
+	for (int32 i = 0; i < 256; i++)
+	{
+		Permutation[i] = static_cast<uint8>(i);
+	}
+	
+	// Fisher-Yates shuffle so the permutation only depends on the seed.
+	FRandomStream RandomStream(Seed);
+	for (int32 i = 255; i > 0; i--)
+	{
+		Swap(Permutation[i], Permutation[RandomStream.RandRange(0, i)]);
+	}
+	
+	for (int32 i = 0; i < 256; i++)
+	{
+		Permutation[i + 256] = Permutation[i];
+	}
+}
+
+void FLandscapeNoise::GenerateHeights(int32 Width, int32 Height, float VertexSpacing,
+	const FLandscapeNoiseSettings& Settings, TArray<float>& OutHeights) const
+{
+	OutHeights.SetNumUninitialized(Width * Height);
+	if (Width <= 0 || Height <= 0) return;
+
+	const int32 NumOctaves = FMath::Max(Settings.Octaves, 1);
+	
+	// Normalise by the total amplitude so heights stay within +/- Scale however many octaves are layered.
+	float TotalAmplitude = 0.0f;
+	float Amplitude = 1.0f;
+	for (int32 Octave = 0; Octave < NumOctaves; Octave++)
+	{
+		TotalAmplitude += Amplitude;
+		Amplitude *= Settings.Gain;
+	}
+	const float HeightScale = TotalAmplitude > 0.0f ? Settings.Scale / TotalAmplitude : 0.0f;
+	
+	// The noise repeats every 256 units so wrapping the offset keeps float precision without changing the result.
+	const float Offset = FMath::Fmod(Settings.Offset, 256.0f);
+
+	float* HeightData = OutHeights.GetData();
+	ParallelFor(Height, [&](int32 Y)
+	{
+		float* RowHeights = HeightData + Y * Width;
+		float Xs[RowBlockSize];
+		float Noise[RowBlockSize];
+		
+		for (int32 BlockStart = 0; BlockStart < Width; BlockStart += RowBlockSize)
+		{
+			const int32 BlockCount = FMath::Min(RowBlockSize, Width - BlockStart);
+			float* BlockHeights = RowHeights + BlockStart;
+			for (int32 i = 0; i < BlockCount; i++)
+			{
+				BlockHeights[i] = 0.0f;
+			}
+			
+			float Frequency = Settings.Roughness;
+			float OctaveAmplitude = 1.0f;
+			for (int32 Octave = 0; Octave < NumOctaves; Octave++)
+			{
+				const float OctaveOffset = Offset + Octave * OctaveShift;
+				for (int32 i = 0; i < BlockCount; i++)
+				{
+					Xs[i] = (BlockStart + i) * VertexSpacing * Frequency + OctaveOffset;
+				}
+				PerlinRow(Xs, Y * VertexSpacing * Frequency + OctaveOffset, BlockCount, Noise);
+				for (int32 i = 0; i < BlockCount; i++)
+				{
+					BlockHeights[i] += Noise[i] * OctaveAmplitude;
+				}
+				Frequency *= Settings.Lacunarity;
+				OctaveAmplitude *= Settings.Gain;
+			}
+			
+			for (int32 i = 0; i < BlockCount; i++)
+			{
+				BlockHeights[i] *= HeightScale;
+			}
+		}
+	});
+}
+
+float FLandscapeNoise::Perlin2D(float X, float Y) const
+{
+	float Noise;
+	PerlinRow(&X, Y, 1, &Noise);
+	return Noise;
+}
+
+void FLandscapeNoise::PerlinRow(const float* Xs, float Y, int32 Count, float* OutNoise) const
+{
+	// Everything that only depends on Y is shared by the whole row.
+	const float Yfl = FMath::FloorToFloat(Y);
+	const int32 Yi = static_cast<int32>(Yfl) & 255;
+	const float Yf = Y - Yfl;
+	const float Yfm1 = Yf - 1.0f;
+	const float V = Fade(Yf);
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		const float Xfl = FMath::FloorToFloat(Xs[i]);
+		const int32 Xi = static_cast<int32>(Xfl) & 255;
+		const float Xf = Xs[i] - Xfl;
+		const float Xfm1 = Xf - 1.0f;
+		const float U = Fade(Xf);
+
+		// Hash each corner of the lattice cell to pick its gradient.
+		const int32 A = Permutation[Xi] + Yi;
+		const int32 B = Permutation[Xi + 1] + Yi;
+		const int32 HashAA = Permutation[A] & 7;
+		const int32 HashAB = Permutation[A + 1] & 7;
+		const int32 HashBA = Permutation[B] & 7;
+		const int32 HashBB = Permutation[B + 1] & 7;
+
+		const float NoiseAA = GradientX[HashAA] * Xf + GradientY[HashAA] * Yf;
+		const float NoiseBA = GradientX[HashBA] * Xfm1 + GradientY[HashBA] * Yf;
+		const float NoiseAB = GradientX[HashAB] * Xf + GradientY[HashAB] * Yfm1;
+		const float NoiseBB = GradientX[HashBB] * Xfm1 + GradientY[HashBB] * Yfm1;
+
+		OutNoise[i] = FMath::Lerp(FMath::Lerp(NoiseAA, NoiseBA, U), FMath::Lerp(NoiseAB, NoiseBB, U), V);
+	}
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The settings used to turn Perlin noise into landscape heights. Multiple octaves of noise are layered on top of each
+ * other (fractal Brownian motion) with each octave having Lacunarity times the frequency and Gain times the amplitude
+ * of the previous one.
+ */
+struct FLandscapeNoiseSettings
+{
+	float Scale = 1000.0f;
+	float Roughness = 0.00012f;
+	float Offset = 0.0f;
+	int32 Octaves = 1;
+	float Lacunarity = 2.0f;
+	float Gain = 0.5f;
+};
+
+/**
+ * Gradient noise that is evaluated a row at a time so that the heights of a whole landscape can be generated in
+ * parallel. This has no dependencies on any UObjects so it is safe to use from any thread.
+ */
+class AGP_API FLandscapeNoise
+{
+public:
+	/**
+	 * @param Seed The seed used to shuffle the lattice gradients. The same seed always produces the same noise.
+	 */
+	explicit FLandscapeNoise(int32 Seed = 0);
+
+	/**
+	 * Will fill OutHeights with the height of every vertex in a Width x Height grid, in row major order. Rows are
+	 * generated in parallel.
+	 * @param Width The grid width of the landscape.
+	 * @param Height The grid height of the landscape.
+	 * @param VertexSpacing The distance between neighbouring vertices.
+	 * @param Settings The noise settings to use.
+	 * @param OutHeights The resulting heights. Will be resized to Width * Height.
+	 */
+	void GenerateHeights(int32 Width, int32 Height, float VertexSpacing, const FLandscapeNoiseSettings& Settings,
+		TArray<float>& OutHeights) const;
+
+	/**
+	 * Will evaluate the noise at a single location. Matches the values produced by GenerateHeights.
+	 * @return A value in the (-1, 1) range.
+	 */
+	float Perlin2D(float X, float Y) const;
+
+private:
+	/**
+	 * Will evaluate the noise for Count positions that all share the same Y coordinate.
+	 */
+	void PerlinRow(const float* Xs, float Y, int32 Count, float* OutNoise) const;
+
+	// Doubled so that lookups of P[P[X] + Y] never need to wrap.
+	uint8 Permutation[512];
+};
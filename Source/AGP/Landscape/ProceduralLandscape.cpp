@@ -3,8 +3,11 @@
 
 #include "ProceduralLandscape.h"
 #include "ProceduralMeshComponent.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Kismet/KismetSystemLibrary.h"
-#include "KismetProceduralMeshLibrary.h"
+#include "Net/UnrealNetwork.h"
 #include "AGP/Pathfinding/PathfindingSubsystem.h"
 
 // Sets default values
@@ -17,16 +20,41 @@ AProceduralLandscape::AProceduralLandscape()
 	ProceduralMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Procedural Mesh"));
 	// Set this procedural mesh as the root component of this actor.
 	SetRootComponent(ProceduralMesh);
+	// Only the seed is replicated. The mesh itself is built on every machine.
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	CollisionMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Collision Mesh"));
+	CollisionMesh->SetupAttachment(ProceduralMesh);
+	CollisionMesh->SetVisibility(false);
+	// Cook the collision off the game thread.
+	CollisionMesh->bUseAsyncCooking = true;
 }
 
 void AProceduralLandscape::ClearLandscape()
 {
+	// Any build that is still running is abandoned. It only works on its own copy of the data so it is safe to leave
+	// it to finish in the background.
+	BuildTask = TFuture<TSharedPtr<FLandscapeBuildData>>();
 	Vertices.Empty();
 	Triangles.Empty();
 	UVCoords.Empty();
+	Heights.Empty();
+	Normals.Empty();
+	Tangents.Empty();
+	Chunks.Empty();
+	ChunkMeshes.Empty();
+	NumChunksX = 0;
+	NumChunksY = 0;
+	bChunkSectionsOutOfDate = false;
+	BuiltSettings = FLandscapeBuildSettings();
 	if (ProceduralMesh)
 	{
-		ProceduralMesh->ClearMeshSection(0);
+		ProceduralMesh->ClearAllMeshSections();
+	}
+	if (CollisionMesh)
+	{
+		CollisionMesh->ClearAllMeshSections();
 	}
 	UKismetSystemLibrary::FlushPersistentDebugLines(GetWorld());
 }
@@ -37,6 +65,76 @@ void AProceduralLandscape::BeginPlay()
 	Super::BeginPlay();
 
 	// CreateSimplePlane();
+	if (bGenerateOnBeginPlay)
+	{
+		if (bRandomiseSeedOnBeginPlay && HasAuthority())
+		{
+			Seed = FMath::Rand();
+		}
+		// Without randomising, the level's seed is the server's too, and a seed that is the same as the class default
+		// is never replicated. Clients only wait for OnRep_Seed when the server picks a seed of its own.
+		if (HasAuthority() || !bRandomiseSeedOnBeginPlay)
+		{
+			bShouldRegenerate = true;
+		}
+	}
+	else
+	{
+		// Normally already done in PostLoad, but actors duplicated for play in editor aren't always loaded.
+		RestoreFromSavedVertices();
+	}
+}
+
+void AProceduralLandscape::PostLoad()
+{
+	Super::PostLoad();
+	// Done here rather than in BeginPlay so that actors asking for the ground height in their own BeginPlay get an
+	// answer whatever order they begin play in.
+	RestoreFromSavedVertices();
+}
+
+bool AProceduralLandscape::RestoreFromSavedVertices()
+{
+	if (Heights.Num() > 0 || Width <= 0 || Height <= 0) return false;
+	if (Vertices.Num() != Width * Height || UVCoords.Num() != Vertices.Num()) return false;
+	// The settings have been changed since the landscape was built, without it being built again.
+	if (Width > 1 && !FMath::IsNearlyEqual(Vertices[1].X - Vertices[0].X, VertexSpacing)) return false;
+
+	BuiltSettings = MakeBuildSettings();
+	Heights.SetNumUninitialized(Vertices.Num());
+	for (int32 VertexIndex = 0; VertexIndex < Vertices.Num(); VertexIndex++)
+	{
+		Heights[VertexIndex] = Vertices[VertexIndex].Z;
+	}
+	FLandscapeBuilder::CalculateGridNormalsAndTangents(Heights, Width, Height, VertexSpacing, Normals, Tangents);
+
+	// Every chunk starts at full detail and UpdateChunkLODs picks the right level of detail from there.
+	Chunks = FLandscapeChunk::Partition(Width, Height, ChunkSize, NumChunksX, NumChunksY);
+	ChunkMeshes.SetNum(Chunks.Num());
+	ParallelFor(Chunks.Num(), [this](int32 ChunkIndex)
+	{
+		FLandscapeBuilder::GatherChunkVertices(Chunks[ChunkIndex], Width, Vertices, Normals, UVCoords, Tangents,
+			ChunkMeshes[ChunkIndex]);
+	});
+	bChunkSectionsOutOfDate = true;
+	return true;
+}
+
+void AProceduralLandscape::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(AProceduralLandscape, Seed);
+}
+
+void AProceduralLandscape::OnRep_Seed()
+{
+	// A landscape built in the editor is loaded the same on every machine, so only one generated at play is built
+	// from the server's seed.
+	if (!bGenerateOnBeginPlay || bShouldRegenerate) return;
+	// The landscape is only built once per seed, so a client that already built from its level seed doesn't build
+	// again when the same seed arrives.
+	if (PendingBuildSettings.Width > 0 && PendingBuildSettings.Seed == Seed) return;
+	bShouldRegenerate = true;
 }
 
 void AProceduralLandscape::CreateSimplePlane()
@@ -69,50 +167,327 @@ void AProceduralLandscape::CreateSimplePlane()
 	}
 }
 
+FLandscapeBuildSettings AProceduralLandscape::MakeBuildSettings() const
+{
+	FLandscapeBuildSettings BuildSettings;
+	BuildSettings.Width = Width;
+	BuildSettings.Height = Height;
+	BuildSettings.VertexSpacing = VertexSpacing;
+	BuildSettings.Seed = Seed;
+	BuildSettings.Noise.Scale = PerlinScale;
+	BuildSettings.Noise.Roughness = PerlinRoughness;
+	BuildSettings.Noise.Offset = PerlinOffset;
+	BuildSettings.Noise.Octaves = PerlinOctaves;
+	BuildSettings.Noise.Lacunarity = PerlinLacunarity;
+	BuildSettings.Noise.Gain = PerlinGain;
+	BuildSettings.Erosion.ThermalIterations = ThermalErosionIterations;
+	BuildSettings.Erosion.TalusAngle = TalusAngle;
+	BuildSettings.Erosion.ThermalRate = ThermalErosionRate;
+	BuildSettings.Erosion.HydraulicIterations = HydraulicErosionIterations;
+	BuildSettings.Erosion.RainAmount = RainAmount;
+	BuildSettings.Erosion.SedimentCapacity = SedimentCapacity;
+	BuildSettings.Erosion.ErosionRate = HydraulicErosionRate;
+	BuildSettings.Erosion.DepositionRate = DepositionRate;
+	BuildSettings.Erosion.EvaporationRate = EvaporationRate;
+	BuildSettings.ChunkSize = ChunkSize;
+	BuildSettings.LandscapeTransform = GetActorTransform();
+	BuildSettings.LODDistance = LODDistance;
+	return BuildSettings;
+}
+
 void AProceduralLandscape::GenerateLandscape()
 {
-	PerlinOffset = FMath::RandRange(-1'000'000.0f, 1'000'000.0f);
-	for (int32 Y = 0; Y < Height; Y++)
-	{
-		for (int32 X = 0; X < Width; X++)
-		{
-			FVector VertexLocation = FVector(X * VertexSpacing, Y * VertexSpacing, 0.0f);
-			float ZHeight = FMath::PerlinNoise2D(
-				FVector2D(VertexLocation.X * PerlinRoughness + PerlinOffset, VertexLocation.Y * PerlinRoughness + PerlinOffset));
-			ZHeight *= PerlinScale;
-			VertexLocation.Z = ZHeight;
-			Vertices.Add(VertexLocation);
-			UVCoords.Add(FVector2D(X, Y));
-			
-			// DrawDebugSphere(GetWorld(), VertexLocation, 50.0f, 8, FColor::Blue,
-			// 	true, -1, 0, 10.0f);
-
-			// Ignore adding triangles if we are at the far left or top of the grid.
-			if (X == Width - 1 || Y == Height - 1) continue;
-			Triangles.Add(Y * Width + X);
-			Triangles.Add((Y+1) * Width + X);
-			Triangles.Add(Y * Width + X+1);
-			Triangles.Add(Y * Width + X+1);
-			Triangles.Add((Y+1) * Width + X);
-			Triangles.Add((Y+1) * Width + X+1);
+	// Everything random is drawn from the seed so the same seed always gives the same landscape.
+	FRandomStream RandomStream(Seed);
+	PerlinOffset = RandomStream.FRandRange(-1'000'000.0f, 1'000'000.0f);
+
+	// Copy everything the build needs so that the worker thread never touches this actor.
+	FLandscapeBuildSettings BuildSettings = MakeBuildSettings();
+	BuildSettings.bUseCache = bCacheGeneratedLandscape && GetWorld() && GetWorld()->IsGameWorld();
+	if (bEnableChunkLOD && GetWorld())
+	{
+		BuildSettings.ViewLocations = GetWorld()->ViewLocationsRenderedLastFrame;
+	}
+
+	// If the grid layout hasn't changed then the triangles, UVs and chunks can all be kept and only the heights
+	// need to be generated.
+	const bool bHeightsOnly = CanUpdateInPlace();
+	PendingBuildSettings = BuildSettings;
+	BuildTask = Async(EAsyncExecution::ThreadPool, [BuildSettings, bHeightsOnly]()
+	{
+		TSharedPtr<FLandscapeBuildData> BuildData = MakeShared<FLandscapeBuildData>();
+		if (bHeightsOnly)
+		{
+			FLandscapeBuilder::BuildHeights(BuildSettings, *BuildData);
+		} else
+		{
+			FLandscapeBuilder::Build(BuildSettings, *BuildData);
 		}
+		return BuildData;
+	});
+}
+
+bool AProceduralLandscape::CanUpdateInPlace() const
+{
+	return Chunks.Num() > 0
+		&& Vertices.Num() == Width * Height
+		&& BuiltSettings.Width == Width
+		&& BuiltSettings.Height == Height
+		&& BuiltSettings.VertexSpacing == VertexSpacing
+		&& BuiltSettings.ChunkSize == ChunkSize;
+}
+
+bool AProceduralLandscape::IsBuildInProgress() const
+{
+	return BuildTask.IsValid();
+}
+
+void AProceduralLandscape::ApplyLandscapeBuild(FLandscapeBuildData& BuildData)
+{
+	// The collision section is replaced rather than cleared so the old collision stays until the new one has cooked.
+	if (ProceduralMesh)
+	{
+		ProceduralMesh->ClearAllMeshSections();
 	}
 
+	Heights = MoveTemp(BuildData.Heights);
+	Vertices = MoveTemp(BuildData.Vertices);
+	UVCoords = MoveTemp(BuildData.UVCoords);
+	Triangles = MoveTemp(BuildData.Triangles);
+	Normals = MoveTemp(BuildData.Normals);
+	Tangents = MoveTemp(BuildData.Tangents);
+	Chunks = MoveTemp(BuildData.Chunks);
+	ChunkMeshes = MoveTemp(BuildData.ChunkMeshes);
+	NumChunksX = BuildData.NumChunksX;
+	NumChunksY = BuildData.NumChunksY;
+	BuiltSettings = PendingBuildSettings;
+	bChunkSectionsOutOfDate = false;
+
 	if (ProceduralMesh)
 	{
-		TArray<FVector> Normals;
-		TArray<FProcMeshTangent> Tangents;
-		UKismetProceduralMeshLibrary::CalculateTangentsForMesh(Vertices, Triangles, UVCoords, Normals, Tangents);
-		ProceduralMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UVCoords,
-			TArray<FColor>(), Tangents, true);
+		// The chunk triangles were already built by the worker so this is only the upload.
+		for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+		{
+			const FLandscapeChunkMesh& ChunkMesh = ChunkMeshes[ChunkIndex];
+			ProceduralMesh->CreateMeshSection(ChunkIndex, ChunkMesh.Vertices, ChunkMesh.Triangles, ChunkMesh.Normals,
+				ChunkMesh.UVCoords, TArray<FColor>(), ChunkMesh.Tangents, false);
+		}
+		UploadCollision();
+		
 		if (UPathfindingSubsystem* PathfindingSubsystem = GetWorld()->GetSubsystem<UPathfindingSubsystem>())
 		{
-			PathfindingSubsystem->PlaceProceduralNodes(Vertices, Width, Height);
+			PathfindingSubsystem->PlaceProceduralNodes(Vertices, BuiltSettings.Width, BuiltSettings.Height);
 		} else
 		{
 			UE_LOG(LogTemp, Error, TEXT("Can't find the pathfinding subsystem"))
 		}
 	}
+
+	OnLandscapeGenerated.Broadcast(this);
+}
+
+void AProceduralLandscape::ApplyHeightUpdate(FLandscapeBuildData& BuildData)
+{
+	Heights = MoveTemp(BuildData.Heights);
+	Normals = MoveTemp(BuildData.Normals);
+	Tangents = MoveTemp(BuildData.Tangents);
+	BuiltSettings = PendingBuildSettings;
+
+	// Only the heights change so the rest of each vertex is left alone.
+	ParallelFor(Vertices.Num(), [this](int32 VertexIndex)
+	{
+		Vertices[VertexIndex].Z = Heights[VertexIndex];
+	});
+	// Gathering resets the chunk arrays without freeing them, so no memory is reallocated here.
+	ParallelFor(Chunks.Num(), [this](int32 ChunkIndex)
+	{
+		FLandscapeBuilder::GatherChunkVertices(Chunks[ChunkIndex], BuiltSettings.Width, Vertices, Normals, UVCoords,
+			Tangents, ChunkMeshes[ChunkIndex]);
+	});
+
+	if (ProceduralMesh)
+	{
+		// The UVs and colours are passed empty so that they aren't uploaded again.
+		for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+		{
+			const FLandscapeChunkMesh& ChunkMesh = ChunkMeshes[ChunkIndex];
+			ProceduralMesh->UpdateMeshSection(ChunkIndex, ChunkMesh.Vertices, ChunkMesh.Normals, TArray<FVector2D>(),
+				TArray<FColor>(), ChunkMesh.Tangents);
+		}
+		// Updating the vertices of a section doesn't change its collision under Chaos, so the collision is cooked
+		// again asynchronously, the same as after a full build.
+		UploadCollision();
+		
+		if (UPathfindingSubsystem* PathfindingSubsystem = GetWorld()->GetSubsystem<UPathfindingSubsystem>())
+		{
+			PathfindingSubsystem->UpdateProceduralNodeLocations(Vertices, BuiltSettings.Width,
+				BuiltSettings.Height);
+		} else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Can't find the pathfinding subsystem"))
+		}
+	}
+
+	OnLandscapeGenerated.Broadcast(this);
+}
+
+void AProceduralLandscape::RebuildChunk(int32 ChunkIndex)
+{
+	if (!Chunks.IsValidIndex(ChunkIndex)) return;
+	FLandscapeBuilder::GatherChunkVertices(Chunks[ChunkIndex], BuiltSettings.Width, Vertices, Normals, UVCoords,
+		Tangents, ChunkMeshes[ChunkIndex]);
+	UploadChunkSection(ChunkIndex);
+	UploadCollision();
+}
+
+void AProceduralLandscape::UploadChunkSection(int32 ChunkIndex)
+{
+	if (!ProceduralMesh) return;
+	FLandscapeChunkMesh& ChunkMesh = ChunkMeshes[ChunkIndex];
+	Chunks[ChunkIndex].BuildTriangles(
+		FLandscapeBuilder::GetChunkNeighbours(Chunks, NumChunksX, NumChunksY, ChunkIndex), ChunkMesh.Triangles);
+	ProceduralMesh->CreateMeshSection(ChunkIndex, ChunkMesh.Vertices, ChunkMesh.Triangles, ChunkMesh.Normals,
+		ChunkMesh.UVCoords, TArray<FColor>(), ChunkMesh.Tangents, false);
+}
+
+void AProceduralLandscape::UploadCollision()
+{
+	if (!CollisionMesh) return;
+	// The procedural mesh component cooks every section together whenever any section changes, so the collision is
+	// kept as one full detail section to only ever start a single cook.
+	CollisionMesh->CreateMeshSection(0, Vertices, Triangles, TArray<FVector>(), TArray<FVector2D>(),
+		TArray<FColor>(), TArray<FProcMeshTangent>(), true);
+}
+
+int32 AProceduralLandscape::GetDesiredLODStep(const FLandscapeChunk& Chunk, const TArray<FVector>& ViewLocations) const
+{
+	if (!bEnableChunkLOD) return 1;
+	return FLandscapeBuilder::GetDesiredLODStep(Chunk, GetActorTransform(), BuiltSettings.VertexSpacing, LODDistance,
+		ViewLocations);
+}
+
+void AProceduralLandscape::UpdateChunkLODs()
+{
+	const TArray<FVector>& ViewLocations = GetWorld()->ViewLocationsRenderedLastFrame;
+	// Nothing is being rendered, such as on a dedicated server, so there is no reason to change detail.
+	if (ViewLocations.IsEmpty()) return;
+
+	TSet<int32> DirtyChunks;
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+	{
+		const int32 DesiredStep = GetDesiredLODStep(Chunks[ChunkIndex], ViewLocations);
+		if (DesiredStep == Chunks[ChunkIndex].LODStep) continue;
+		
+		Chunks[ChunkIndex].LODStep = DesiredStep;
+		const int32 ChunkX = ChunkIndex % NumChunksX;
+		const int32 ChunkY = ChunkIndex / NumChunksX;
+		DirtyChunks.Add(ChunkIndex);
+		for (const int32 NeighbourIndex : {
+			FLandscapeBuilder::GetChunkIndex(NumChunksX, NumChunksY, ChunkX - 1, ChunkY),
+			FLandscapeBuilder::GetChunkIndex(NumChunksX, NumChunksY, ChunkX + 1, ChunkY),
+			FLandscapeBuilder::GetChunkIndex(NumChunksX, NumChunksY, ChunkX, ChunkY - 1),
+			FLandscapeBuilder::GetChunkIndex(NumChunksX, NumChunksY, ChunkX, ChunkY + 1) })
+		{
+			if (NeighbourIndex != INDEX_NONE)
+			{
+				DirtyChunks.Add(NeighbourIndex);
+			}
+		}
+	}
+
+	for (const int32 ChunkIndex : DirtyChunks)
+	{
+		UploadChunkSection(ChunkIndex);
+	}
+}
+
+bool AProceduralLandscape::SampleHeightfield(float LocalX, float LocalY, float& OutHeight, FVector* OutNormal) const
+{
+	const int32 GridWidth = BuiltSettings.Width;
+	const int32 GridHeight = BuiltSettings.Height;
+	if (GridWidth <= 0 || GridHeight <= 0 || BuiltSettings.VertexSpacing <= 0.0f
+		|| Heights.Num() != GridWidth * GridHeight) return false;
+
+	const float GridX = LocalX / BuiltSettings.VertexSpacing;
+	const float GridY = LocalY / BuiltSettings.VertexSpacing;
+	if (GridX < 0.0f || GridY < 0.0f || GridX > GridWidth - 1 || GridY > GridHeight - 1) return false;
+
+	// Find the four vertices around the position. On the far edges the cell is clamped inwards.
+	const int32 X0 = FMath::Clamp(FMath::FloorToInt32(GridX), 0, FMath::Max(GridWidth - 2, 0));
+	const int32 Y0 = FMath::Clamp(FMath::FloorToInt32(GridY), 0, FMath::Max(GridHeight - 2, 0));
+	const int32 X1 = FMath::Min(X0 + 1, GridWidth - 1);
+	const int32 Y1 = FMath::Min(Y0 + 1, GridHeight - 1);
+	const float AlphaX = GridX - X0;
+	const float AlphaY = GridY - Y0;
+
+	const int32 Index00 = Y0 * GridWidth + X0;
+	const int32 Index10 = Y0 * GridWidth + X1;
+	const int32 Index01 = Y1 * GridWidth + X0;
+	const int32 Index11 = Y1 * GridWidth + X1;
+	OutHeight = FMath::Lerp(
+		FMath::Lerp(Heights[Index00], Heights[Index10], AlphaX),
+		FMath::Lerp(Heights[Index01], Heights[Index11], AlphaX),
+		AlphaY);
+
+	if (OutNormal)
+	{
+		if (Normals.Num() != Heights.Num()) return false;
+		*OutNormal = FMath::Lerp(
+			FMath::Lerp(Normals[Index00], Normals[Index10], AlphaX),
+			FMath::Lerp(Normals[Index01], Normals[Index11], AlphaX),
+			AlphaY).GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+	}
+	return true;
+}
+
+bool AProceduralLandscape::GetHeightAtLocation(const FVector& WorldLocation, float& OutHeight) const
+{
+	const FTransform& LandscapeTransform = GetActorTransform();
+	const FVector LocalLocation = LandscapeTransform.InverseTransformPosition(WorldLocation);
+	float LocalHeight;
+	if (!SampleHeightfield(LocalLocation.X, LocalLocation.Y, LocalHeight)) return false;
+	OutHeight = LandscapeTransform.TransformPosition(FVector(LocalLocation.X, LocalLocation.Y, LocalHeight)).Z;
+	return true;
+}
+
+bool AProceduralLandscape::GetNormalAtLocation(const FVector& WorldLocation, FVector& OutNormal) const
+{
+	const FTransform& LandscapeTransform = GetActorTransform();
+	const FVector LocalLocation = LandscapeTransform.InverseTransformPosition(WorldLocation);
+	float LocalHeight;
+	FVector LocalNormal;
+	if (!SampleHeightfield(LocalLocation.X, LocalLocation.Y, LocalHeight, &LocalNormal)) return false;
+	OutNormal = LandscapeTransform.TransformVectorNoScale(LocalNormal);
+	return true;
+}
+
+bool AProceduralLandscape::GetSlopeAtLocation(const FVector& WorldLocation, float& OutSlope) const
+{
+	FVector Normal;
+	if (!GetNormalAtLocation(WorldLocation, Normal)) return false;
+	OutSlope = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(Normal.Z, -1.0, 1.0)));
+	return true;
+}
+
+bool AProceduralLandscape::SnapLocationToGround(FVector& Location, float HeightOffset) const
+{
+	float GroundHeight;
+	if (!GetHeightAtLocation(Location, GroundHeight)) return false;
+	Location.Z = GroundHeight + HeightOffset;
+	return true;
+}
+
+int32 AProceduralLandscape::SnapLocationsToGround(TArray<FVector>& Locations, float HeightOffset) const
+{
+	FThreadSafeCounter NumSnapped;
+	ParallelFor(Locations.Num(), [this, &Locations, &NumSnapped, HeightOffset](int32 LocationIndex)
+	{
+		if (SnapLocationToGround(Locations[LocationIndex], HeightOffset))
+		{
+			NumSnapped.Increment();
+		}
+	});
+	return NumSnapped.GetValue();
 }
 
 bool AProceduralLandscape::ShouldTickIfViewportsOnly() const
@@ -125,12 +500,48 @@ void AProceduralLandscape::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (bShouldRegenerate)
+	// Only one build runs at a time. A regenerate requested during a build is started once it finishes.
+	if (bShouldRegenerate && !IsBuildInProgress())
 	{
-		ClearLandscape();
 		//CreateSimplePlane();
 		GenerateLandscape();
 		bShouldRegenerate = false;
 	}
+
+	if (BuildTask.IsValid() && BuildTask.IsReady())
+	{
+		const TSharedPtr<FLandscapeBuildData> BuildData = BuildTask.Get();
+		BuildTask = TFuture<TSharedPtr<FLandscapeBuildData>>();
+		if (BuildData.IsValid() && BuildData->bHeightsOnly)
+		{
+			ApplyHeightUpdate(*BuildData);
+		} else if (BuildData.IsValid())
+		{
+			ApplyLandscapeBuild(*BuildData);
+		}
+	}
+
+	if (bChunkSectionsOutOfDate)
+	{
+		bChunkSectionsOutOfDate = false;
+		if (ProceduralMesh)
+		{
+			ProceduralMesh->ClearAllMeshSections();
+			for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+			{
+				UploadChunkSection(ChunkIndex);
+			}
+		}
+	}
+
+	if (bEnableChunkLOD && Chunks.Num() > 0)
+	{
+		TimeSinceLODUpdate += DeltaTime;
+		if (TimeSinceLODUpdate >= LODUpdateInterval)
+		{
+			TimeSinceLODUpdate = 0.0f;
+			UpdateChunkLODs();
+		}
+	}
 }
 
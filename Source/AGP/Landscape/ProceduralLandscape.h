@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "LandscapeBuilder.h"
+#include "Async/Future.h"
 #include "ProceduralLandscape.generated.h"
 
-struct FProcMeshTangent;
-class UProceduralMeshComponent;
+class AProceduralLandscape;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLandscapeGenerated, AProceduralLandscape*);
 
 UCLASS()
 class AGP_API AProceduralLandscape : public AActor
@@ -19,18 +22,129 @@ public:
 	AProceduralLandscape();
 
 	virtual bool ShouldTickIfViewportsOnly() const override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	void ClearLandscape();
+	/**
+	 * Will rebuild the render and collision sections of a single chunk from the landscape's vertex data. No other
+	 * chunk's mesh section is touched.
+	 * @param ChunkIndex The index of the chunk in row major order.
+	 */
+	void RebuildChunk(int32 ChunkIndex);
+	/**
+	 * @return True if the landscape is currently being built on a worker thread.
+	 */
+	bool IsBuildInProgress() const;
+
+	// Heightfield Queries
+	/**
+	 * Will sample the height of the landscape at a world location by bilinearly interpolating the stored height grid.
+	 * No physics traces are used so this is cheap enough to call for every spawn.
+	 * @param WorldLocation The location to sample. Only X and Y are used.
+	 * @param OutHeight The world Z of the landscape surface at that location.
+	 * @return False if the location is outside of the landscape or the landscape hasn't been built yet.
+	 */
+	bool GetHeightAtLocation(const FVector& WorldLocation, float& OutHeight) const;
+	/**
+	 * Will sample the surface normal of the landscape at a world location by bilinearly interpolating the stored
+	 * vertex normals.
+	 * @param WorldLocation The location to sample. Only X and Y are used.
+	 * @param OutNormal The world space unit normal of the landscape surface at that location.
+	 * @return False if the location is outside of the landscape or the landscape hasn't been built yet.
+	 */
+	bool GetNormalAtLocation(const FVector& WorldLocation, FVector& OutNormal) const;
+	/**
+	 * @param WorldLocation The location to sample. Only X and Y are used.
+	 * @param OutSlope The angle of the landscape surface from horizontal, in degrees.
+	 * @return False if the location is outside of the landscape or the landscape hasn't been built yet.
+	 */
+	bool GetSlopeAtLocation(const FVector& WorldLocation, float& OutSlope) const;
+	/**
+	 * Will move a location so that it sits on the landscape surface.
+	 * @param Location The location to snap. Only Z is changed.
+	 * @param HeightOffset How far above the surface to place the location.
+	 * @return False if the location is outside of the landscape, in which case it is left unchanged.
+	 */
+	bool SnapLocationToGround(FVector& Location, float HeightOffset = 0.0f) const;
+	/**
+	 * Will move many locations so that they sit on the landscape surface. The locations are processed in parallel.
+	 * @param Locations The locations to snap. Only Z is changed. Any outside of the landscape are left unchanged.
+	 * @param HeightOffset How far above the surface to place the locations.
+	 * @return The number of locations that were snapped.
+	 */
+	int32 SnapLocationsToGround(TArray<FVector>& Locations, float HeightOffset = 0.0f) const;
+
+	/**
+	 * Broadcast on the game thread once a landscape build has finished and its mesh sections and navigation nodes
+	 * have been created. Collision may still be cooking at this point.
+	 */
+	FOnLandscapeGenerated OnLandscapeGenerated;
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void PostLoad() override;
 
 	UPROPERTY(VisibleAnywhere)
 	UProceduralMeshComponent* ProceduralMesh;
+	/**
+	 * Holds a full detail copy of the landscape for collision, as a single section that is cooked asynchronously. This
+	 * is kept separate from the rendered mesh so that changing a chunk's level of detail doesn't cause the collision
+	 * to be cooked again.
+	 */
+	UPROPERTY(VisibleAnywhere)
+	UProceduralMeshComponent* CollisionMesh;
 
 	void CreateSimplePlane();
+	/**
+	 * @return The current generation settings in the form the builder takes. The cache and level of detail settings
+	 * that depend on the world are left at their defaults.
+	 */
+	FLandscapeBuildSettings MakeBuildSettings() const;
+	/**
+	 * Only the vertices, triangles and UVs are saved with the level, so a landscape built in the editor loads without
+	 * its height grid or chunks. This will rebuild the heights, normals, tangents and chunks from the saved vertices
+	 * so the heightfield queries and chunk levels of detail work without generating the landscape again. Does nothing
+	 * if they are already built or the saved vertices don't match the current settings.
+	 * @return True if the landscape was restored.
+	 */
+	bool RestoreFromSavedVertices();
+	/**
+	 * Will start building a new landscape on a worker thread. The current landscape stays in place until the build
+	 * has finished and is swapped in by ApplyLandscapeBuild.
+	 */
 	void GenerateLandscape();
+	/**
+	 * Will replace the current landscape with a finished build and upload its mesh sections. Called on the game thread.
+	 * @param BuildData The finished build. Its arrays are moved out of.
+	 */
+	void ApplyLandscapeBuild(FLandscapeBuildData& BuildData);
+	/**
+	 * Will write new heights, normals and tangents into the existing vertex buffers and push them to the mesh sections
+	 * with UpdateMeshSection. The triangles, UVs and chunks are left as they are. The collision is cooked again. Called
+	 * on the game thread.
+	 * @param BuildData A finished heights only build. Its arrays are moved out of.
+	 */
+	void ApplyHeightUpdate(FLandscapeBuildData& BuildData);
+	/**
+	 * @return True if the landscape has already been built with the same grid layout as its current settings, so only
+	 * the heights need to be regenerated.
+	 */
+	bool CanUpdateInPlace() const;
+	/**
+	 * Will bilinearly sample the height grid at a position in the landscape's local space.
+	 * @param LocalX The local X position.
+	 * @param LocalY The local Y position.
+	 * @param OutHeight The local height of the surface.
+	 * @param OutNormal If not null, will be set to the local space normal of the surface.
+	 * @return False if the position is outside of the grid or nothing has been built.
+	 */
+	bool SampleHeightfield(float LocalX, float LocalY, float& OutHeight, FVector* OutNormal = nullptr) const;
+
+	TFuture<TSharedPtr<FLandscapeBuildData>> BuildTask;
+	// The settings of the build that is running and the build that is currently applied.
+	FLandscapeBuildSettings PendingBuildSettings;
+	FLandscapeBuildSettings BuiltSettings;
 
 	UPROPERTY()
 	TArray<FVector> Vertices;
@@ -38,8 +152,62 @@ protected:
 	TArray<int32> Triangles;
 	UPROPERTY()
 	TArray<FVector2D> UVCoords;
+	/**
+	 * The height of every vertex in the grid, in row major order. Generated in parallel before the mesh is built.
+	 */
+	TArray<float> Heights;
+	TArray<FVector> Normals;
+	TArray<FProcMeshTangent> Tangents;
+
+	// Chunk Logic
+	TArray<FLandscapeChunk> Chunks;
+	TArray<FLandscapeChunkMesh> ChunkMeshes;
+	int32 NumChunksX = 0;
+	int32 NumChunksY = 0;
+	float TimeSinceLODUpdate = 0.0f;
+	// Set when the chunks were restored from the saved vertices. The saved mesh sections could be for a different
+	// chunk layout or level of detail, so every chunk is uploaded again on the next tick.
+	bool bChunkSectionsOutOfDate = false;
+
+	void UploadChunkSection(int32 ChunkIndex);
+	void UploadCollision();
+	int32 GetDesiredLODStep(const FLandscapeChunk& Chunk, const TArray<FVector>& ViewLocations) const;
+	/**
+	 * Will pick a level of detail for every chunk based on its distance to the cameras. Only the chunks whose level
+	 * of detail changed, and their direct neighbours whose edges need stitching again, are rebuilt.
+	 */
+	void UpdateChunkLODs();
 
 	// Landscape Generation Settings.
+	/**
+	 * Everything about the generated landscape comes from this seed and the settings below. Only the seed is
+	 * replicated, each client then builds the identical landscape and navigation grid itself.
+	 */
+	UPROPERTY(EditAnywhere, ReplicatedUsing=OnRep_Seed)
+	int32 Seed = 0;
+	/**
+	 * If true the landscape is generated when play begins rather than only in the editor. If the server randomises
+	 * the seed, clients wait until they have the server's seed before generating it.
+	 */
+	UPROPERTY(EditAnywhere)
+	bool bGenerateOnBeginPlay = false;
+	/**
+	 * If true the server picks a new random seed when play begins. Requires bGenerateOnBeginPlay.
+	 */
+	UPROPERTY(EditAnywhere, meta=(EditCondition="bGenerateOnBeginPlay"))
+	bool bRandomiseSeedOnBeginPlay = false;
+
+	/**
+	 * If true the generated heights are cached on disk, keyed by the generation settings, and loaded instead of being
+	 * generated again next time. Only used in game worlds so that tweaking settings in the editor doesn't fill the
+	 * cache.
+	 */
+	UPROPERTY(EditAnywhere)
+	bool bCacheGeneratedLandscape = true;
+
+	UFUNCTION()
+	void OnRep_Seed();
+
 	UPROPERTY(EditAnywhere)
 	int32 Width = 10;
 	UPROPERTY(EditAnywhere)
@@ -51,8 +219,71 @@ protected:
 	float PerlinScale = 1000.0f;
 	UPROPERTY(EditAnywhere)
 	float PerlinRoughness = 0.00012f;
+	/**
+	 * The number of layers of noise that are added together. Each extra octave adds finer detail.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="1", ClampMax="12"))
+	int32 PerlinOctaves = 1;
+	/**
+	 * How much the frequency is multiplied by for each successive octave.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="1.0"))
+	float PerlinLacunarity = 2.0f;
+	/**
+	 * How much the amplitude is multiplied by for each successive octave.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="1.0"))
+	float PerlinGain = 0.5f;
 	UPROPERTY(VisibleAnywhere)
 	float PerlinOffset;
+
+	// Erosion Settings.
+	/**
+	 * How many times thermal erosion is run. This wears down any slopes steeper than the talus angle. Set to 0 to
+	 * turn it off.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	int32 ThermalErosionIterations = 0;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="89.0"))
+	float TalusAngle = 35.0f;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="1.0"))
+	float ThermalErosionRate = 0.5f;
+	/**
+	 * How many times hydraulic erosion is run. This rains water over the landscape which carves out valleys as it
+	 * flows downhill. Set to 0 to turn it off.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	int32 HydraulicErosionIterations = 0;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0"))
+	float RainAmount = 2.0f;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0"))
+	float SedimentCapacity = 0.5f;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="1.0"))
+	float HydraulicErosionRate = 0.3f;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="1.0"))
+	float DepositionRate = 0.3f;
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0", ClampMax="1.0"))
+	float EvaporationRate = 0.05f;
+
+	/**
+	 * The number of grid quads along each side of a chunk. Each chunk is its own mesh section. Should be a power of two
+	 * so that chunks can be drawn at lower levels of detail.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="2"))
+	int32 ChunkSize = 32;
+	UPROPERTY(EditAnywhere)
+	bool bEnableChunkLOD = true;
+	/**
+	 * Chunks closer than this to a camera are drawn at full detail. Every time the distance doubles after that the
+	 * chunk is drawn with half as many quads along each side.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0"))
+	float LODDistance = 20000.0f;
+	/**
+	 * How often, in seconds, the chunk levels of detail are updated.
+	 */
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0.0"))
+	float LODUpdateInterval = 0.25f;
 	
 	UPROPERTY(EditAnywhere)
 	bool bShouldRegenerate;
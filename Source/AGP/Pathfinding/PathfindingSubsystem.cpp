@@ -5,6 +5,7 @@
 
 #include "EngineUtils.h"
 #include "NavigationNode.h"
+#include "Algo/Reverse.h"
 
 void UPathfindingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
@@ -40,6 +41,47 @@ TArray<FVector> UPathfindingSubsystem::GetPathAway(const FVector& StartLocation,
 	return GetPath(FindNearestNode(StartLocation), FindFurthestNode(TargetLocation));
 }
 
+TArray<FVector> UPathfindingSubsystem::GetCooperativePath(const UObject* Agent, const FVector& StartLocation, const FVector& TargetLocation)
+{
+	ReleaseReservations(Agent);
+	PruneExpiredReservations();
+	return GetPath(FindNearestNode(StartLocation), FindNearestNode(TargetLocation), Agent);
+}
+
+TArray<FVector> UPathfindingSubsystem::GetCooperativePathAway(const UObject* Agent, const FVector& StartLocation, const FVector& TargetLocation)
+{
+	ReleaseReservations(Agent);
+	PruneExpiredReservations();
+	return GetPath(FindNearestNode(StartLocation), FindFurthestNode(TargetLocation), Agent);
+}
+
+void UPathfindingSubsystem::ReleaseReservations(const UObject* Agent)
+{
+	TArray<FNodeReservation> Reservations;
+	if (!AgentReservations.RemoveAndCopyValue(Agent, Reservations)) return;
+
+	for (const FNodeReservation& Reservation : Reservations)
+	{
+		if (int32* Count = ReservationTable.Find(Reservation))
+		{
+			if (--(*Count) <= 0)
+			{
+				ReservationTable.Remove(Reservation);
+			}
+		}
+	}
+}
+
+void UPathfindingSubsystem::SetCooperativePathfindingEnabled(bool bEnabled)
+{
+	bUseCooperativePathfinding = bEnabled;
+	if (!bUseCooperativePathfinding)
+	{
+		ReservationTable.Empty();
+		AgentReservations.Empty();
+	}
+}
+
 void UPathfindingSubsystem::PlaceProceduralNodes(const TArray<FVector>& LandscapeVertexData, int32 MapWidth, int32 MapHeight)
 {
 	// Need to destroy all of the current nodes in the world.
@@ -99,6 +141,22 @@ void UPathfindingSubsystem::PlaceProceduralNodes(const TArray<FVector>& Landscap
 	}
 }
 
+void UPathfindingSubsystem::UpdateProceduralNodeLocations(const TArray<FVector>& LandscapeVertexData, int32 MapWidth,
+	int32 MapHeight)
+{
+	if (ProcedurallyPlacedNodes.Num() != MapWidth * MapHeight || ProcedurallyPlacedNodes.ContainsByPredicate(
+		[](const ANavigationNode* Node) { return !IsValid(Node); }))
+	{
+		PlaceProceduralNodes(LandscapeVertexData, MapWidth, MapHeight);
+		return;
+	}
+
+	for (int32 i = 0; i < ProcedurallyPlacedNodes.Num(); i++)
+	{
+		ProcedurallyPlacedNodes[i]->SetActorLocation(LandscapeVertexData[i]);
+	}
+}
+
 void UPathfindingSubsystem::PopulateNodes()
 {
 	Nodes.Empty();
@@ -114,6 +172,9 @@ void UPathfindingSubsystem::RemoveAllNodes()
 {
 	Nodes.Empty();
 	ProcedurallyPlacedNodes.Empty();
+	// Any reservations would be pointing at nodes that are about to be destroyed.
+	ReservationTable.Empty();
+	AgentReservations.Empty();
 
 	for (TActorIterator<ANavigationNode> It(GetWorld()); It; ++It)
 	{
@@ -185,7 +246,7 @@ ANavigationNode* UPathfindingSubsystem::FindFurthestNode(const FVector& TargetLo
 	return FurthestNode;
 }
 
-TArray<FVector> UPathfindingSubsystem::GetPath(ANavigationNode* StartNode, ANavigationNode* EndNode)
+TArray<FVector> UPathfindingSubsystem::GetPath(ANavigationNode* StartNode, ANavigationNode* EndNode, const UObject* ReservingAgent)
 {
 	if (!StartNode || !EndNode)
 	{
@@ -212,6 +273,15 @@ TArray<FVector> UPathfindingSubsystem::GetPath(ANavigationNode* StartNode, ANavi
 	HScores.Add(StartNode, FVector::Distance(StartNode->GetActorLocation(), EndNode->GetActorLocation()));
 	CameFrom.Add(StartNode, nullptr);
 
+	// When avoiding reservations the GScores also contain the reservation penalties, so the actual distance travelled
+	// is tracked separately. This is used to estimate the time slot that the agent would arrive at each node.
+	const bool bAvoidReservations = ReservingAgent && bUseCooperativePathfinding;
+	TMap<ANavigationNode*, float> TravelDistances;
+	if (bAvoidReservations)
+	{
+		TravelDistances.Add(StartNode, 0.0f);
+	}
+
 	while (!OpenSet.IsEmpty())
 	{
 		// Find the node in the open set with the lowest FScore.
@@ -232,13 +302,25 @@ TArray<FVector> UPathfindingSubsystem::GetPath(ANavigationNode* StartNode, ANavi
 		{
 			// Then we have found the path so reconstruct it and get the positions of each of the nodes in the path.
 			// UE_LOG(LogTemp, Display, TEXT("PATH FOUND"))
+			if (bAvoidReservations)
+			{
+				ReservePath(ReservingAgent, CameFrom, TravelDistances, EndNode);
+			}
 			return ReconstructPath(CameFrom, EndNode);
 		}
 
 		for (ANavigationNode* ConnectedNode : CurrentNode->ConnectedNodes)
 		{
 			if (!ConnectedNode) continue; // Failsafe if the ConnectedNode is a nullptr.
-			const float TentativeGScore = GScores[CurrentNode] + FVector::Distance(CurrentNode->GetActorLocation(), ConnectedNode->GetActorLocation());
+			const float EdgeDistance = FVector::Distance(CurrentNode->GetActorLocation(), ConnectedNode->GetActorLocation());
+			float TentativeGScore = GScores[CurrentNode] + EdgeDistance;
+			float TentativeTravelDistance = 0.0f;
+			if (bAvoidReservations)
+			{
+				// Make it more expensive to step onto a node at the same time as other agents plan to be there.
+				TentativeTravelDistance = TravelDistances[CurrentNode] + EdgeDistance;
+				TentativeGScore += GetReservationCount(ConnectedNode, GetReservationSlot(TentativeTravelDistance)) * ReservationPenalty;
+			}
 			// Because we didn't setup all the scores and came from at the start, we need to check if the connected node has a gscore
 			// already otherwise set it. If it doesn't have a gscore then it won't have all the other things either so initialise them as well.
 			if (!GScores.Contains(ConnectedNode))
@@ -253,6 +335,10 @@ TArray<FVector> UPathfindingSubsystem::GetPath(ANavigationNode* StartNode, ANavi
 			{
 				CameFrom[ConnectedNode] = CurrentNode;
 				GScores[ConnectedNode] = TentativeGScore;
+				if (bAvoidReservations)
+				{
+					TravelDistances.Add(ConnectedNode, TentativeTravelDistance);
+				}
 				// HScore is already set when adding the node to the HScores map.
 				// Then add connected node to the open set if it isn't already in there.
 				if (!OpenSet.Contains(ConnectedNode))
@@ -282,3 +368,72 @@ TArray<FVector> UPathfindingSubsystem::ReconstructPath(const TMap<ANavigationNod
 	return NodeLocations;
 }
 
+int32 UPathfindingSubsystem::GetCurrentReservationSlot() const
+{
+	return FMath::FloorToInt32(GetWorld()->GetTimeSeconds() / ReservationSlotDuration);
+}
+
+int32 UPathfindingSubsystem::GetReservationSlot(float TravelDistance) const
+{
+	return GetCurrentReservationSlot() + FMath::FloorToInt32(TravelDistance / (ReservationAgentSpeed * ReservationSlotDuration));
+}
+
+int32 UPathfindingSubsystem::GetReservationCount(const ANavigationNode* Node, int32 Slot) const
+{
+	const int32* Count = ReservationTable.Find(FNodeReservation(Node, Slot));
+	return Count ? *Count : 0;
+}
+
+void UPathfindingSubsystem::ReservePath(const UObject* Agent, const TMap<ANavigationNode*, ANavigationNode*>& CameFromMap,
+	const TMap<ANavigationNode*, float>& TravelDistances, ANavigationNode* EndNode)
+{
+	// Walk back from the end node to get the nodes in the order they will be visited.
+	TArray<ANavigationNode*> PathNodes;
+	for (ANavigationNode* Node = EndNode; Node; Node = CameFromMap[Node])
+	{
+		PathNodes.Add(Node);
+	}
+	Algo::Reverse(PathNodes);
+
+	TArray<FNodeReservation>& Reservations = AgentReservations.FindOrAdd(Agent);
+	const int32 NumReservedSteps = FMath::Min(PathNodes.Num(), ReservationWindow);
+	for (int32 i = 0; i < NumReservedSteps; i++)
+	{
+		// Reserve the arrival slot and the one after it to cover the time the agent spends moving through the node.
+		const int32 ArrivalSlot = GetReservationSlot(TravelDistances[PathNodes[i]]);
+		for (int32 Slot = ArrivalSlot; Slot <= ArrivalSlot + 1; Slot++)
+		{
+			const FNodeReservation Reservation(PathNodes[i], Slot);
+			ReservationTable.FindOrAdd(Reservation)++;
+			Reservations.Add(Reservation);
+		}
+	}
+}
+
+void UPathfindingSubsystem::PruneExpiredReservations()
+{
+	// Only need to prune once per time slot as reservations only expire when the slot changes.
+	const int32 CurrentSlot = GetCurrentReservationSlot();
+	if (CurrentSlot == LastPrunedSlot) return;
+	LastPrunedSlot = CurrentSlot;
+
+	for (auto It = AgentReservations.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAll([this, CurrentSlot](const FNodeReservation& Reservation)
+		{
+			if (Reservation.Value >= CurrentSlot) return false;
+			if (int32* Count = ReservationTable.Find(Reservation))
+			{
+				if (--(*Count) <= 0)
+				{
+					ReservationTable.Remove(Reservation);
+				}
+			}
+			return true;
+		});
+		if (It.Value().IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
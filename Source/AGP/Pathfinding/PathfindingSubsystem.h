@@ -45,6 +45,35 @@ public:
 	 */
 	TArray<FVector> GetPathAway(const FVector& StartLocation, const FVector& TargetLocation);
 
+	// Cooperative Pathfinding Logic
+	/**
+	 * Will retrieve a path from the StartLocation, to the TargetLocation while steering around nodes that other agents
+	 * have reserved for the time they would arrive there. The first ReservationWindow steps of the resulting path are
+	 * then reserved for this agent so that agents asking for a path afterwards get spread across alternative routes.
+	 * If cooperative pathfinding is disabled this behaves exactly like GetPath.
+	 * @param Agent The object the path is for. Any reservations previously held by this agent are released first.
+	 * @param StartLocation The location that the path will start at.
+	 * @param TargetLocation A location near where the path will end at.
+	 * @return An array of vector positions representing the steps along the path, in reverse order.
+	 */
+	TArray<FVector> GetCooperativePath(const UObject* Agent, const FVector& StartLocation, const FVector& TargetLocation);
+	/**
+	 * Will retrieve a path from the StartLocation, to a position far away from the TargetLocation, using the same
+	 * reservation rules as GetCooperativePath.
+	 * @param Agent The object the path is for. Any reservations previously held by this agent are released first.
+	 * @param StartLocation The location that the path will start at.
+	 * @param TargetLocation The location that will be used to determine a position far away from.
+	 * @return An array of vector positions representing the steps along the path, in reverse order.
+	 */
+	TArray<FVector> GetCooperativePathAway(const UObject* Agent, const FVector& StartLocation, const FVector& TargetLocation);
+	/**
+	 * Will remove all of the node reservations held by the given agent. Should be called when the agent is removed
+	 * from the world or no longer follows its path.
+	 * @param Agent The object whose reservations should be released.
+	 */
+	void ReleaseReservations(const UObject* Agent);
+	void SetCooperativePathfindingEnabled(bool bEnabled);
+
 	// Procedural Map Logic
 	/**
 	 * Will place down navigation nodes at the vertex positions, excluding the edge vertex positions and
@@ -55,6 +84,14 @@ public:
 	 * @param MapHeight The grid height of the landscape.
 	 */
 	void PlaceProceduralNodes(const TArray<FVector>& LandscapeVertexData, int32 MapWidth, int32 MapHeight);
+	/**
+	 * Will move the already placed procedural nodes to the new vertex positions without respawning them or
+	 * rebuilding their connections. If the grid size doesn't match the placed nodes then they are placed again.
+	 * @param LandscapeVertexData The mesh vertex positions of the landscape.
+	 * @param MapWidth The grid width of the landscape.
+	 * @param MapHeight The grid height of the landscape.
+	 */
+	void UpdateProceduralNodeLocations(const TArray<FVector>& LandscapeVertexData, int32 MapWidth, int32 MapHeight);
 
 protected:
 	
@@ -63,6 +100,42 @@ protected:
 	// Procedural Map Logic
 	TArray<ANavigationNode*> ProcedurallyPlacedNodes;
 
+	// Cooperative Pathfinding Logic
+	/**
+	 * A reservation is a node paired with the time slot that an agent is expected to be standing on it.
+	 */
+	using FNodeReservation = TPair<const ANavigationNode*, int32>;
+
+	bool bUseCooperativePathfinding = true;
+	/**
+	 * The length of a single reservation time slot in seconds.
+	 */
+	float ReservationSlotDuration = 1.0f;
+	/**
+	 * The speed, in cm/s, used to estimate when an agent will arrive at each node along its path.
+	 */
+	float ReservationAgentSpeed = 600.0f;
+	/**
+	 * How many steps from the start of a path are reserved. Only the near future is reserved (WHCA* style) as the
+	 * estimate of when an agent arrives at a node gets less accurate further along the path.
+	 */
+	int32 ReservationWindow = 8;
+	/**
+	 * The extra cost added for every other agent that has reserved a node for the same time slot. This is a soft
+	 * penalty rather than a hard block so that a path is still found when every route is contested.
+	 */
+	float ReservationPenalty = 2000.0f;
+
+	/**
+	 * The number of agents that have reserved each node for each time slot.
+	 */
+	TMap<FNodeReservation, int32> ReservationTable;
+	/**
+	 * The reservations held by each agent so they can be released when the agent asks for a new path.
+	 */
+	TMap<const UObject*, TArray<FNodeReservation>> AgentReservations;
+	int32 LastPrunedSlot = 0;
+
 private:
 
 	void PopulateNodes();
@@ -70,7 +143,14 @@ private:
 	ANavigationNode* GetRandomNode();
 	ANavigationNode* FindNearestNode(const FVector& TargetLocation);
 	ANavigationNode* FindFurthestNode(const FVector& TargetLocation);
-	TArray<FVector> GetPath(ANavigationNode* StartNode, ANavigationNode* EndNode);
+	TArray<FVector> GetPath(ANavigationNode* StartNode, ANavigationNode* EndNode, const UObject* ReservingAgent = nullptr);
 	static TArray<FVector> ReconstructPath(const TMap<ANavigationNode*, ANavigationNode*>& CameFromMap, ANavigationNode* EndNode);
+
+	int32 GetCurrentReservationSlot() const;
+	int32 GetReservationSlot(float TravelDistance) const;
+	int32 GetReservationCount(const ANavigationNode* Node, int32 Slot) const;
+	void ReservePath(const UObject* Agent, const TMap<ANavigationNode*, ANavigationNode*>& CameFromMap,
+		const TMap<ANavigationNode*, float>& TravelDistances, ANavigationNode* EndNode);
+	void PruneExpiredReservations();
 	
 };
@@ -3,10 +3,26 @@
 
 #include "PickupManagerSubsystem.h"
 
+#include "EngineUtils.h"
 #include "WeaponPickup.h"
 #include "AGP/AGPGameInstance.h"
+#include "AGP/Landscape/ProceduralLandscape.h"
 #include "AGP/Pathfinding/PathfindingSubsystem.h"
 
+void UPickupManagerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AProceduralLandscape> It(&InWorld); It; ++It)
+	{
+		if (!Landscape)
+		{
+			Landscape = *It;
+		}
+		It->OnLandscapeGenerated.AddUObject(this, &UPickupManagerSubsystem::OnLandscapeGenerated);
+	}
+}
+
 void UPickupManagerSubsystem::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -62,4 +78,14 @@ void UPickupManagerSubsystem::PopulateSpawnLocations()
 	{
 		PossibleSpawnLocations = PathfindingSubsystem->GetWaypointPositions();
 	}
+	// Put the locations on the actual ground rather than trusting where the nodes were placed.
+	if (Landscape)
+	{
+		Landscape->SnapLocationsToGround(PossibleSpawnLocations);
+	}
+}
+
+void UPickupManagerSubsystem::OnLandscapeGenerated(AProceduralLandscape* GeneratedLandscape)
+{
+	PopulateSpawnLocations();
 }
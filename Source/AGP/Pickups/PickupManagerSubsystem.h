@@ -7,6 +7,7 @@
 #include "PickupManagerSubsystem.generated.h"
 
 class AWeaponPickup;
+class AProceduralLandscape;
 /**
  * 
  */
@@ -21,12 +22,19 @@ public:
 		return TStatId();
 	}
 
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
 protected:
 	
 	/**
 	 * The world locations of all possible locations that a pickup can spawn.
 	 */
 	TArray<FVector> PossibleSpawnLocations;
+	/**
+	 * The landscape that spawn locations are snapped to. Null if the level doesn't have a procedural landscape.
+	 */
+	UPROPERTY()
+	AProceduralLandscape* Landscape;
 	float PickupSpawnRate = 5.0f;
 	float TimeSinceLastSpawn = 0.0f;
 	
@@ -36,5 +44,9 @@ private:
 
 	void SpawnWeaponPickup();
 	void PopulateSpawnLocations();
+	/**
+	 * Refreshes the spawn locations once a landscape has finished generating and placed its new navigation nodes.
+	 */
+	void OnLandscapeGenerated(AProceduralLandscape* GeneratedLandscape);
 	
 };